@@ -10,6 +10,7 @@ public class GRBShooterTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.Latest;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+		bWithPushModel = true;
 		ExtraModuleNames.AddRange( new string[] { "GRBShooter" } );
 	}
 }
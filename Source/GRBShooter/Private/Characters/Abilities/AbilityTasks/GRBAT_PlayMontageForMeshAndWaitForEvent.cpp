@@ -15,6 +15,7 @@ UGRBAT_PlayMontageForMeshAndWaitForEvent::UGRBAT_PlayMontageForMeshAndWaitForEve
 {
 	Rate = 1.f;
 	bStopWhenAbilityEnds = true;
+	bKeepAliveAfterMontageEnded = false;
 }
 
 UGRBAbilitySystemComponent* UGRBAT_PlayMontageForMeshAndWaitForEvent::GetTargetASC()
@@ -81,7 +82,10 @@ void UGRBAT_PlayMontageForMeshAndWaitForEvent::OnMontageEnded(UAnimMontage* Mont
 		}
 	}
 
-	EndTask();
+	if (!bKeepAliveAfterMontageEnded)
+	{
+		EndTask();
+	}
 }
 
 void UGRBAT_PlayMontageForMeshAndWaitForEvent::OnGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload)
@@ -117,6 +121,74 @@ UGRBAT_PlayMontageForMeshAndWaitForEvent* UGRBAT_PlayMontageForMeshAndWaitForEve
 	return MyObj;
 }
 
+UGRBAT_PlayMontageForMeshAndWaitForEvent* UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(UGRBAT_PlayMontageForMeshAndWaitForEvent* InExistingTask,
+	UGameplayAbility* OwningAbility, USkeletalMeshComponent* InMesh, UAnimMontage* MontageToPlay, float Rate, FName StartSection, bool bStopWhenAbilityEnds, bool bReplicateMontage)
+{
+	if (InExistingTask && InExistingTask->Ability == OwningAbility && InExistingTask->GetMesh() == InMesh && InExistingTask->RestartMontage(MontageToPlay, Rate, StartSection))
+	{
+		return InExistingTask;
+	}
+
+	// 旧任务不再被调用方持有; 播完后保活的任务不会自行结束, 这里结束掉以免泄漏
+	if (InExistingTask && InExistingTask->IsActive())
+	{
+		InExistingTask->EndTask();
+	}
+
+	UGRBAT_PlayMontageForMeshAndWaitForEvent* MyObj = PlayMontageForMeshAndWaitForEvent(OwningAbility, FName("None"), InMesh, MontageToPlay, FGameplayTagContainer(), Rate, StartSection,
+	                                                                                     bStopWhenAbilityEnds, 1.f, bReplicateMontage, -1.f, -1.f);
+	MyObj->bKeepAliveAfterMontageEnded = true;
+	MyObj->ReadyForActivation();
+	return MyObj;
+}
+
+bool UGRBAT_PlayMontageForMeshAndWaitForEvent::RestartMontage(UAnimMontage* InMontageToPlay, float InRate, FName InStartSection)
+{
+	// 仅在首次播放成功(回调均已绑定)且任务仍在运行时可复用
+	if (!IsActive() || Ability == nullptr || Mesh == nullptr || InMontageToPlay == nullptr || !BlendingOutDelegate.IsBound() || !MontageEndedDelegate.IsBound())
+	{
+		return false;
+	}
+
+	UGRBAbilitySystemComponent* GRBAbilitySystemComponent = GetTargetASC();
+	UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	if (!GRBAbilitySystemComponent || !AnimInstance)
+	{
+		return false;
+	}
+
+	UAbilitySystemGlobals::NonShipping_ApplyGlobalAbilityScaler_Rate(InRate);
+
+	// 上一段还在播放时会在PlayMontageForMesh内部被新一段打断, 因此只能在播放前解绑其回调, 避免触发 OnInterrupted 或结束任务
+	if (FAnimMontageInstance* PrevMontageInstance = AnimInstance->GetActiveInstanceForMontage(MontageToPlay))
+	{
+		PrevMontageInstance->OnMontageBlendingOutStarted.Unbind();
+		PrevMontageInstance->OnMontageEnded.Unbind();
+	}
+
+	MontageToPlay = InMontageToPlay;
+	Rate = InRate;
+	StartSection = InStartSection;
+
+	if (GRBAbilitySystemComponent->PlayMontageForMesh(Ability, Mesh, Ability->GetCurrentActivationInfo(), MontageToPlay, Rate, StartSection, bReplicateMontage) <= 0.f)
+	{
+		// 回调已解绑, 本任务再也收不到蒙太奇的结束通知; 直接结束, 由调用方重新建任务
+		EndTask();
+		return false;
+	}
+
+	// Playing a montage could potentially fire off a callback into game code which could kill this ability!
+	if (ShouldBroadcastAbilityTaskDelegates() == false)
+	{
+		return false;
+	}
+
+	// 单播回调随蒙太奇实例走, 每段都要重新挂到新实例上; 委托对象本身沿用
+	AnimInstance->Montage_SetBlendingOutDelegate(BlendingOutDelegate, MontageToPlay);
+	AnimInstance->Montage_SetEndDelegate(MontageEndedDelegate, MontageToPlay);
+	return true;
+}
+
 void UGRBAT_PlayMontageForMeshAndWaitForEvent::Activate()
 {
 	if (Ability == nullptr)
@@ -3,14 +3,20 @@
 
 #include "Characters/Abilities/AbilityTasks/GRBAT_WaitChangeFOV.h"
 #include "Camera/CameraComponent.h"
+#include "Characters/GRBFOVAnimatorComponent.h"
 #include "Curves/CurveFloat.h"
 #include "GRBShooter/GRBShooter.h"
 
 UGRBAT_WaitChangeFOV::UGRBAT_WaitChangeFOV(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	bTickingTask = true;
-	bIsFinished = false;
+	// 插值由相机管理器推进, 本任务只等待结果
+	bTickingTask = false;
+	TargetFOV = 90.0f;
+	Duration = 0.0f;
+	CameraComponent = nullptr;
+	LerpCurve = nullptr;
+	ChangeId = 0;
 }
 
 UGRBAT_WaitChangeFOV* UGRBAT_WaitChangeFOV::WaitChangeFOV(UGameplayAbility* OwningAbility, FName TaskInstanceName, class UCameraComponent* CameraComponent, float TargetFOV, float Duration, UCurveFloat* OptionalInterpolationCurve)
@@ -18,15 +24,8 @@ UGRBAT_WaitChangeFOV* UGRBAT_WaitChangeFOV::WaitChangeFOV(UGameplayAbility* Owni
 	UGRBAT_WaitChangeFOV* MyObj = NewAbilityTask<UGRBAT_WaitChangeFOV>(OwningAbility, TaskInstanceName);
 
 	MyObj->CameraComponent = CameraComponent;
-	if (CameraComponent != nullptr)
-	{
-		MyObj->StartFOV = MyObj->CameraComponent->FieldOfView;
-	}
-
 	MyObj->TargetFOV = TargetFOV;
-	MyObj->Duration = FMath::Max(Duration, 0.001f); // Avoid negative or divide-by-zero cases
-	MyObj->TimeChangeStarted = MyObj->GetWorld()->GetTimeSeconds();
-	MyObj->TimeChangeWillEnd = MyObj->TimeChangeStarted + MyObj->Duration;
+	MyObj->Duration = Duration;
 	MyObj->LerpCurve = OptionalInterpolationCurve;
 
 	return MyObj;
@@ -34,56 +33,41 @@ UGRBAT_WaitChangeFOV* UGRBAT_WaitChangeFOV::WaitChangeFOV(UGameplayAbility* Owni
 
 void UGRBAT_WaitChangeFOV::Activate()
 {
-}
-
-void UGRBAT_WaitChangeFOV::TickTask(float DeltaTime)
-{
-	if (bIsFinished)
+	UGRBFOVAnimatorComponent* const Animator = CameraComponent ? UGRBFOVAnimatorComponent::FindOrAddFOVAnimator(CameraComponent->GetOwner()) : nullptr;
+	if (!Animator)
 	{
+		EndTask();
 		return;
 	}
 
-	Super::TickTask(DeltaTime);
+	// 先挂好回调再开始; 没有本地相机时插值会在StartFOVChange内同步完成
+	FOVAnimator = Animator;
+	ChangeId = Animator->GetNextFOVChangeId();
+	FOVChangeFinishedHandle = Animator->OnFOVChangeFinished.AddUObject(this, &UGRBAT_WaitChangeFOV::OnFOVChangeFinished);
+	Animator->StartFOVChange(CameraComponent, TargetFOV, Duration, LerpCurve);
+}
 
-	if (CameraComponent)
+void UGRBAT_WaitChangeFOV::OnFOVChangeFinished(uint32 InChangeId, bool bReachedTarget)
+{
+	if (InChangeId != ChangeId)
 	{
-		float CurrentTime = GetWorld()->GetTimeSeconds();
-
-		if (CurrentTime >= TimeChangeWillEnd)
-		{
-			bIsFinished = true;
-
-			CameraComponent->SetFieldOfView(TargetFOV);
-
-			if (ShouldBroadcastAbilityTaskDelegates())
-			{
-				OnTargetFOVReached.Broadcast();
-			}
-			EndTask();
-		}
-		else
-		{
-			float NewFOV;
-
-			float MoveFraction = (CurrentTime - TimeChangeStarted) / Duration;
-			if (LerpCurve)
-			{
-				MoveFraction = LerpCurve->GetFloatValue(MoveFraction);
-			}
-
-			NewFOV = FMath::Lerp<float, float>(StartFOV, TargetFOV, MoveFraction);
-
-			CameraComponent->SetFieldOfView(NewFOV);
-		}
+		return;
 	}
-	else
+
+	if (bReachedTarget && ShouldBroadcastAbilityTaskDelegates())
 	{
-		bIsFinished = true;
-		EndTask();
+		OnTargetFOVReached.Broadcast();
 	}
+	EndTask();
 }
 
 void UGRBAT_WaitChangeFOV::OnDestroy(bool AbilityIsEnding)
 {
+	if (UGRBFOVAnimatorComponent* const Animator = FOVAnimator.Get())
+	{
+		Animator->OnFOVChangeFinished.Remove(FOVChangeFinishedHandle);
+	}
+	FOVAnimator.Reset();
+
 	Super::OnDestroy(AbilityIsEnding);
 }
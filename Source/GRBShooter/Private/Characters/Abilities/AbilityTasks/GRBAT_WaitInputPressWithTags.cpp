@@ -0,0 +1,207 @@
+// Copyright 2024 GRB.
+
+
+#include "Characters/Abilities/AbilityTasks/GRBAT_WaitInputPressWithTags.h"
+#include "AbilitySystemComponent.h"
+
+UGRBAT_WaitInputPressWithTags::UGRBAT_WaitInputPressWithTags(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bTestInitialState = false;
+	StartTime = 0.0f;
+}
+
+UGRBAT_WaitInputPressWithTags* UGRBAT_WaitInputPressWithTags::WaitInputPressWithTags(UGameplayAbility* OwningAbility, FGameplayTagContainer RequiredTags, FGameplayTagContainer IgnoredTags, bool bTestAlreadyPressed)
+{
+	UGRBAT_WaitInputPressWithTags* MyObj = NewAbilityTask<UGRBAT_WaitInputPressWithTags>(OwningAbility);
+	MyObj->RequiredTags = RequiredTags;
+	MyObj->IgnoredTags = IgnoredTags;
+	MyObj->bTestInitialState = bTestAlreadyPressed;
+
+	return MyObj;
+}
+
+void UGRBAT_WaitInputPressWithTags::Activate()
+{
+	StartTime = GetWorld()->GetTimeSeconds();
+
+	if (Ability == nullptr || !AbilitySystemComponent.IsValid())
+	{
+		return;
+	}
+
+	// 先订阅再检测初始状态: 初始按下不满足标签条件而转入按住等待时, 松开后仍能等到下一次按下
+	ListenForPress();
+
+	if (bTestInitialState && IsLocallyControlled() && !IsFinished())
+	{
+		const FGameplayAbilitySpec* const Spec = Ability->GetCurrentAbilitySpec();
+		if (Spec && Spec->InputPressed)
+		{
+			OnPressCallback();
+		}
+	}
+}
+
+void UGRBAT_WaitInputPressWithTags::OnPressCallback()
+{
+	UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get();
+	if (Ability == nullptr || ASC == nullptr)
+	{
+		EndTask();
+		return;
+	}
+
+	if (AreTagRequirementsMet())
+	{
+		CompletePress();
+		return;
+	}
+
+	// 服务端同样校验标签条件, 不采信客户端的判定: 先消费这次确认按下(否则重新订阅时会立即回放),
+	// 再等待门控标签到位后完成; 客户端已提交这次按下, 因此服务端不随松开放弃等待
+	if (IsForRemoteClient())
+	{
+		ASC->ConsumeGenericReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey());
+		WaitForTagsWhileHeld();
+		return;
+	}
+
+	// 条件不满足: 按下订阅仍然有效, 下一次按下照常回调; 按键仍按住期间额外等待标签事件
+	if (IsLocallyControlled())
+	{
+		WaitForTagsWhileHeld();
+	}
+}
+
+void UGRBAT_WaitInputPressWithTags::OnReleaseCallback()
+{
+	StopWaitingForTagsWhileHeld();
+}
+
+void UGRBAT_WaitInputPressWithTags::OnGateTagChanged(const FGameplayTag InTag, int32 InNewCount)
+{
+	if (!AreTagRequirementsMet())
+	{
+		return;
+	}
+
+	// 服务端等待的是客户端已确认的按下, 条件满足即完成
+	// 本地以技能实例上的按键状态为准, 防止松开事件被其他任务消费而漏掉
+	const FGameplayAbilitySpec* const Spec = Ability ? Ability->GetCurrentAbilitySpec() : nullptr;
+	if (IsForRemoteClient() || (Spec && Spec->InputPressed))
+	{
+		CompletePress();
+	}
+	else
+	{
+		StopWaitingForTagsWhileHeld();
+	}
+}
+
+bool UGRBAT_WaitInputPressWithTags::AreTagRequirementsMet() const
+{
+	const UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get();
+	return ASC && ASC->HasAllMatchingGameplayTags(RequiredTags) && !ASC->HasAnyMatchingGameplayTags(IgnoredTags);
+}
+
+void UGRBAT_WaitInputPressWithTags::ListenForPress()
+{
+	UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get();
+	if (ASC == nullptr)
+	{
+		return;
+	}
+
+	ASC->AbilityReplicatedEventDelegate(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey()).Remove(PressedHandle);
+	PressedHandle = ASC->AbilityReplicatedEventDelegate(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey()).AddUObject(this, &UGRBAT_WaitInputPressWithTags::OnPressCallback);
+
+	if (IsForRemoteClient())
+	{
+		if (!ASC->CallReplicatedEventDelegateIfSet(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey()))
+		{
+			SetWaitingOnRemotePlayerData();
+		}
+	}
+}
+
+void UGRBAT_WaitInputPressWithTags::WaitForTagsWhileHeld()
+{
+	UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get();
+	if (ASC == nullptr || GateTagHandles.Num() > 0)
+	{
+		return;
+	}
+
+	if (!IsForRemoteClient())
+	{
+		ReleasedHandle = ASC->AbilityReplicatedEventDelegate(EAbilityGenericReplicatedEvent::InputReleased, GetAbilitySpecHandle(), GetActivationPredictionKey()).AddUObject(this, &UGRBAT_WaitInputPressWithTags::OnReleaseCallback);
+	}
+
+	for (const FGameplayTag& Tag : RequiredTags)
+	{
+		GateTagHandles.Emplace(Tag, ASC->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &UGRBAT_WaitInputPressWithTags::OnGateTagChanged));
+	}
+	for (const FGameplayTag& Tag : IgnoredTags)
+	{
+		GateTagHandles.Emplace(Tag, ASC->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &UGRBAT_WaitInputPressWithTags::OnGateTagChanged));
+	}
+}
+
+void UGRBAT_WaitInputPressWithTags::StopWaitingForTagsWhileHeld()
+{
+	UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get();
+	if (ASC)
+	{
+		for (const TPair<FGameplayTag, FDelegateHandle>& GateTagHandle : GateTagHandles)
+		{
+			ASC->RegisterGameplayTagEvent(GateTagHandle.Key, EGameplayTagEventType::NewOrRemoved).Remove(GateTagHandle.Value);
+		}
+		ASC->AbilityReplicatedEventDelegate(EAbilityGenericReplicatedEvent::InputReleased, GetAbilitySpecHandle(), GetActivationPredictionKey()).Remove(ReleasedHandle);
+	}
+
+	GateTagHandles.Reset();
+	ReleasedHandle.Reset();
+}
+
+void UGRBAT_WaitInputPressWithTags::CompletePress()
+{
+	UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get();
+	if (ASC == nullptr)
+	{
+		EndTask();
+		return;
+	}
+
+	StopWaitingForTagsWhileHeld();
+	ASC->AbilityReplicatedEventDelegate(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey()).Remove(PressedHandle);
+	PressedHandle.Reset();
+
+	FScopedPredictionWindow ScopedPrediction(ASC, IsPredictingClient());
+	if (IsPredictingClient())
+	{
+		// Tell the server about this
+		ASC->ServerSetReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey(), ASC->ScopedPredictionKey);
+	}
+	else
+	{
+		ASC->ConsumeGenericReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey());
+	}
+
+	if (ShouldBroadcastAbilityTaskDelegates())
+	{
+		OnPress.Broadcast(GetWorld()->GetTimeSeconds() - StartTime);
+	}
+	EndTask();
+}
+
+void UGRBAT_WaitInputPressWithTags::OnDestroy(bool AbilityEnded)
+{
+	StopWaitingForTagsWhileHeld();
+	if (UAbilitySystemComponent* const ASC = AbilitySystemComponent.Get())
+	{
+		ASC->AbilityReplicatedEventDelegate(EAbilityGenericReplicatedEvent::InputPressed, GetAbilitySpecHandle(), GetActivationPredictionKey()).Remove(PressedHandle);
+	}
+
+	Super::OnDestroy(AbilityEnded);
+}
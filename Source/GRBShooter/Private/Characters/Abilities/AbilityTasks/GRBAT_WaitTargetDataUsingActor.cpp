@@ -3,6 +3,7 @@
 
 #include "Characters/Abilities/AbilityTasks/GRBAT_WaitTargetDataUsingActor.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GRBAbilitySystemComponent.h"
 #include "Characters/Abilities/GRBGATA_Trace.h"
 
 UGRBAT_WaitTargetDataUsingActor::UGRBAT_WaitTargetDataUsingActor(const FObjectInitializer& ObjectInitializer)
@@ -145,6 +146,12 @@ void UGRBAT_WaitTargetDataUsingActor::OnTargetDataReadyCallback(const FGameplayA
 	const FGameplayAbilityActorInfo* Info = Ability->GetCurrentActorInfo();
 	if (UAbilityTask::IsPredictingClient())
 	{
+		UGRBAbilitySystemComponent* const GRBASC = Cast<UGRBAbilitySystemComponent>(AbilitySystemComponent.Get());
+		if (GRBASC)
+		{
+			GRBASC->TracePredictionKey(Ability, AbilitySystemComponent->ScopedPredictionKey, EGRBPredictionKeyUsage::TargetData);
+		}
+
 		if (!m_GameplayTargetActor->ShouldProduceTargetDataOnServer)
 		{
 			FGameplayTag ApplicationTag; // Fixme: where would this be useful?
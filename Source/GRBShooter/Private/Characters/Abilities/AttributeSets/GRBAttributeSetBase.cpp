@@ -158,14 +158,8 @@ void UGRBAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCal
 					AGRBPlayerController* PC = Cast<AGRBPlayerController>(SourceController);
 					if (PC)
 					{
-						FGameplayTagContainer DamageNumberTags;
-
-						if (Data.EffectSpec.GetDynamicAssetTags().HasTag(HeadShotTag))
-						{
-							DamageNumberTags.AddTagFast(HeadShotTag);
-						}
-
-						PC->ShowDamageNumber(LocalDamageDone, TargetCharacter, DamageNumberTags);
+						// 并入攻击者的伤害数字聚合窗口, 不再每次命中发一个可靠RPC
+						PC->QueueDamageNumber(LocalDamageDone, TargetCharacter, Data.EffectSpec.GetDynamicAssetTags().HasTag(HeadShotTag));
 					}
 				}
 
@@ -5,7 +5,9 @@
 #include "AbilitySystemGlobals.h"
 #include "AbilitySystemLog.h"
 #include "Animation/AnimInstance.h"
+#include "Characters/GRBCharacterMovementComponent.h"
 #include "Characters/Abilities/GRBGameplayAbility.h"
+#include "GameFramework/Character.h"
 #include "GameplayCueManager.h"
 #include "GRBBlueprintFunctionLibrary.h"
 #include "Net/UnrealNetwork.h"
@@ -20,6 +22,8 @@ static TAutoConsoleVariable<float> CVarReplayMontageErrorThreshold(
 
 UGRBAbilitySystemComponent::UGRBAbilitySystemComponent()
 {
+	InteractingTagPair.Tag = FGameplayTag::RequestGameplayTag("State.Interacting");
+	InteractingTagPair.RemovalTag = FGameplayTag::RequestGameplayTag("State.InteractingRemoval");
 }
 
 void UGRBAbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -70,6 +74,21 @@ void UGRBAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AAct
 	{
 		OnRep_ReplicatedAnimMontageForMesh(); // 客户端收到RepMontage复制之后的客户端表现回调
 	}
+
+	// 交互状态在技能激活检查与移动中每帧都会被查询, 这里先登记好; 重复初始化不再追加引用
+	if (InteractingTagPairIndex == INDEX_NONE)
+	{
+		InteractingTagPairIndex = FindOrAddTagPair(InteractingTagPair.Tag, InteractingTagPair.RemovalTag);
+	}
+
+	// 化身的移动组件在此绑定速度修正回调, 之后GetMaxSpeed只读缓存
+	if (const ACharacter* const AvatarCharacter = Cast<ACharacter>(InAvatarActor))
+	{
+		if (UGRBCharacterMovementComponent* const GRBMovement = Cast<UGRBCharacterMovementComponent>(AvatarCharacter->GetCharacterMovement()))
+		{
+			GRBMovement->BindSpeedModifierDelegates(this);
+		}
+	}
 }
 
 /** 在一个能力（Ability）结束时调用，用于通知系统该能力已经完成、取消或中止。通过这一通知，系统可以进行一些清理工作、触发回调.*/
@@ -234,6 +253,117 @@ FString UGRBAbilitySystemComponent::GetCurrentPredictionKeyStatus()
 	return ScopedPredictionKey.ToString() + " is valid for more prediction: " + (ScopedPredictionKey.IsValidForMorePrediction() ? TEXT("true") : TEXT("false"));
 }
 
+///@brief 登记一对派生状态Tag并返回其索引, 已登记则增加一次引用
+int32 UGRBAbilitySystemComponent::FindOrAddTagPair(const FGameplayTag& InTag, const FGameplayTag& InRemovalTag)
+{
+	const int32 ExistingIndex = TagPairs.IndexOfByPredicate([&InTag, &InRemovalTag](const FGRBTagPair& InPair) { return InPair.RefCount > 0 && InPair.Tag == InTag && InPair.RemovalTag == InRemovalTag; });
+	if (ExistingIndex != INDEX_NONE)
+	{
+		++TagPairs[ExistingIndex].RefCount;
+		return ExistingIndex;
+	}
+	if (!InTag.IsValid() || !InRemovalTag.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	// 优先复用已释放的空位
+	int32 NewIndex = TagPairs.IndexOfByPredicate([](const FGRBTagPair& InPair) { return InPair.RefCount == 0; });
+	if (NewIndex == INDEX_NONE)
+	{
+		if (TagPairs.Num() >= MaxTagPairs)
+		{
+			return INDEX_NONE;
+		}
+		NewIndex = TagPairs.AddDefaulted();
+	}
+
+	FGRBTagPair& Pair = TagPairs[NewIndex];
+	Pair.Tag = InTag;
+	Pair.RemovalTag = InRemovalTag;
+	Pair.RefCount = 1;
+	// 比较的是两个Tag的层数, 因此任一层数变化都要重算
+	Pair.TagEventHandle = RegisterGameplayTagEvent(InTag, EGameplayTagEventType::AnyCountChange).AddUObject(this, &UGRBAbilitySystemComponent::OnTagPairCountChanged, NewIndex);
+	Pair.RemovalTagEventHandle = RegisterGameplayTagEvent(InRemovalTag, EGameplayTagEventType::AnyCountChange).AddUObject(this, &UGRBAbilitySystemComponent::OnTagPairCountChanged, NewIndex);
+	OnTagPairCountChanged(InTag, GetTagCount(InTag), NewIndex);
+	return NewIndex;
+}
+
+///@brief 释放一次对Tag对的引用; 引用归零时注销两个Tag事件并回收该位
+void UGRBAbilitySystemComponent::ReleaseTagPair(int32 InPairIndex)
+{
+	if (!TagPairs.IsValidIndex(InPairIndex) || TagPairs[InPairIndex].RefCount <= 0)
+	{
+		return;
+	}
+
+	FGRBTagPair& Pair = TagPairs[InPairIndex];
+	if (--Pair.RefCount > 0)
+	{
+		return;
+	}
+
+	RegisterGameplayTagEvent(Pair.Tag, EGameplayTagEventType::AnyCountChange).Remove(Pair.TagEventHandle);
+	RegisterGameplayTagEvent(Pair.RemovalTag, EGameplayTagEventType::AnyCountChange).Remove(Pair.RemovalTagEventHandle);
+	Pair = FGRBTagPair();
+	TagPairStateBits &= ~(1u << InPairIndex);
+
+	// 末尾的空位直接收缩掉
+	while (TagPairs.Num() > 0 && TagPairs.Last().RefCount == 0)
+	{
+		TagPairs.Pop(false);
+	}
+}
+
+///--@brief 派生状态中任一Tag层数变化, 重算该位--/
+void UGRBAbilitySystemComponent::OnTagPairCountChanged(const FGameplayTag InTag, int32 InNewCount, int32 InPairIndex)
+{
+	if (!TagPairs.IsValidIndex(InPairIndex) || TagPairs[InPairIndex].RefCount <= 0)
+	{
+		return;
+	}
+
+	const FGRBTagPair& Pair = TagPairs[InPairIndex];
+	const uint32 PairBit = 1u << InPairIndex;
+	if (GetTagCount(Pair.Tag) > GetTagCount(Pair.RemovalTag))
+	{
+		TagPairStateBits |= PairBit;
+	}
+	else
+	{
+		TagPairStateBits &= ~PairBit;
+	}
+}
+
+///@brief 登记一个GRB技能在本地预测端创建的预测Key
+void UGRBAbilitySystemComponent::TracePredictionKey(const UGameplayAbility* InAbility, const FPredictionKey& InKey, EGRBPredictionKeyUsage InUsage)
+{
+	if (!GetWorld() || !PredictionKeyTracker.TraceKeyCreated(this, InAbility, InKey, InUsage, GetWorld()->GetTimeSeconds()))
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (!TimerManager.IsTimerActive(PredictionKeySummaryTimerHandle))
+	{
+		TimerManager.SetTimer(PredictionKeySummaryTimerHandle, this, &UGRBAbilitySystemComponent::UpdatePredictionKeySummary, 1.0f, true);
+	}
+}
+
+///--@brief 每秒汇总一次预测Key统计并检查泄漏; 没有待追踪数据时停下--/
+void UGRBAbilitySystemComponent::UpdatePredictionKeySummary()
+{
+	if (!GetWorld())
+	{
+		return;
+	}
+
+	if (!PredictionKeyTracker.UpdateSummary(GetWorld()->GetTimeSeconds()))
+	{
+		GetWorld()->GetTimerManager().ClearTimer(PredictionKeySummaryTimerHandle);
+	}
+}
+
 ///@brief 给Self施加带预测性质效果的BUFF
 FActiveGameplayEffectHandle UGRBAbilitySystemComponent::BP_ApplyGameplayEffectToSelfWithPrediction(TSubclassOf<UGameplayEffect> GameplayEffectClass, float Level, FGameplayEffectContextHandle EffectContext)
 {
@@ -58,6 +58,8 @@ void AGRBGATA_LineTrace::Configure(
 	{
 		AGRBGATA_Trace::NumberOfTraces = 1;
 	}
+
+	MarkFullyConfigured();
 }
 
 void AGRBGATA_LineTrace::DoTrace(TArray<FHitResult>& HitResults, const UWorld* World, const FGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params)
@@ -62,6 +62,8 @@ void AGRBGATA_SphereTrace::Configure(
 	{
 		NumberOfTraces = 1;
 	}
+
+	MarkFullyConfigured();
 }
 
 void AGRBGATA_SphereTrace::SphereTraceWithFilter(TArray<FHitResult>& OutHitResults, const UWorld* World, const FGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, float Radius, FName ProfileName, const FCollisionQueryParams Params)
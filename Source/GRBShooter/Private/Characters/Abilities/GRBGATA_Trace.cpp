@@ -4,10 +4,14 @@
 #include "Characters/Abilities/GRBGATA_Trace.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemLog.h"
+#include "Characters/Abilities/GRBAbilitySystemComponent.h"
 #include "DrawDebugHelpers.h"
 #include "GameFramework/PlayerController.h"
 #include "GameplayAbilitySpec.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trace Actor Full Configures"), STAT_GRBTraceActorFullConfigures, STATGROUP_GRBAbility);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Trace Actor Patches"), STAT_GRBTraceActorPatches, STATGROUP_GRBAbility);
+
 AGRBGATA_Trace::AGRBGATA_Trace()
 {
 	bDestroyOnConfirmation = false;
@@ -43,6 +47,7 @@ void AGRBGATA_Trace::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	// 把一组可视化3D准星从后到前挨个销毁
 	DestroyReticleActors();
+	ReleaseAimingTagPair();
 	
 	Super::EndPlay(EndPlayReason);
 }
@@ -75,6 +80,21 @@ void AGRBGATA_Trace::StartTargeting(UGameplayAbility* Ability)
 	OwningAbility = Ability;
 	SourceActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
 
+	// 让ASC缓存这对瞄准Tag的派生状态并记下索引, GetCurrentSpread每发只做位测试; ASC与Tag未变时沿用已持有的登记
+	UGRBAbilitySystemComponent* const GRBASC = Cast<UGRBAbilitySystemComponent>(Ability->GetCurrentActorInfo()->AbilitySystemComponent.Get());
+	const bool bWantsAimingTagPair = GRBASC && bUseAimingSpreadMod && AimingTag.IsValid() && AimingRemovalTag.IsValid();
+	if (!bWantsAimingTagPair || AimingTagPairASC.Get() != GRBASC || AimingTagPairTag != AimingTag || AimingTagPairRemovalTag != AimingRemovalTag)
+	{
+		ReleaseAimingTagPair();
+		if (bWantsAimingTagPair)
+		{
+			AimingTagPairASC = GRBASC;
+			AimingTagPairIndex = GRBASC->FindOrAddTagPair(AimingTag, AimingRemovalTag);
+			AimingTagPairTag = AimingTag;
+			AimingTagPairRemovalTag = AimingRemovalTag;
+		}
+	}
+
 	// This is a lazy way of emptying and repopulating the ReticleActors.
 	// We could come up with a solution that reuses them.
 	DestroyReticleActors();
@@ -168,7 +188,9 @@ float AGRBGATA_Trace::GetCurrentSpread() const
 	if (bUseAimingSpreadMod && AimingTag.IsValid() && AimingRemovalTag.IsValid())
 	{
 		UAbilitySystemComponent* ASC = OwningAbility->GetCurrentActorInfo()->AbilitySystemComponent.Get();
-		if (ASC && (ASC->GetTagCount(AimingTag) > ASC->GetTagCount(AimingRemovalTag)))
+		const bool bHasAimingTagPair = AimingTagPairIndex != INDEX_NONE && AimingTagPairASC.Get() == ASC && AimingTagPairTag == AimingTag && AimingTagPairRemovalTag == AimingRemovalTag;
+		const bool bIsAiming = bHasAimingTagPair ? AimingTagPairASC->IsTagPairActive(AimingTagPairIndex) : (ASC && ASC->GetTagCount(AimingTag) > ASC->GetTagCount(AimingRemovalTag));
+		if (bIsAiming)
 		{
 			FinalSpread *= AimingSpreadMod;
 		}
@@ -324,6 +346,19 @@ void AGRBGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FColli
 }
 
 ///--@brief 主动停止目标选择并进行一系列数据/委托清理--/
+///--@brief 释放在ASC上登记的瞄准Tag对--/
+void AGRBGATA_Trace::ReleaseAimingTagPair()
+{
+	if (UGRBAbilitySystemComponent* const GRBASC = AimingTagPairASC.Get())
+	{
+		GRBASC->ReleaseTagPair(AimingTagPairIndex);
+	}
+	AimingTagPairASC.Reset();
+	AimingTagPairIndex = INDEX_NONE;
+	AimingTagPairTag = FGameplayTag();
+	AimingTagPairRemovalTag = FGameplayTag();
+}
+
 void AGRBGATA_Trace::StopTargeting()
 {
 	SetActorTickEnabled(false);
@@ -340,6 +375,34 @@ void AGRBGATA_Trace::StopTargeting()
 	}
 }
 
+///--@brief 仅修补起点相关字段(1P/3P枪口切换); 返回修补后的版本号--/
+uint32 AGRBGATA_Trace::PatchStartLocation(const FGameplayAbilityTargetingLocationInfo& InStartLocation, bool bInTraceFromPlayerViewPoint)
+{
+	AGameplayAbilityTargetActor::StartLocation = InStartLocation;
+	bTraceFromPlayerViewPoint = bInTraceFromPlayerViewPoint;
+	INC_DWORD_STAT(STAT_GRBTraceActorPatches);
+	return ++ConfigVersion;
+}
+
+///--@brief 仅修补单次Trace命中上限; 值未变化时不递增版本号--/
+uint32 AGRBGATA_Trace::PatchMaxHitResults(int32 InMaxHitResultsPerTrace)
+{
+	if (m_MaxAcknowledgeHitNums != InMaxHitResultsPerTrace)
+	{
+		m_MaxAcknowledgeHitNums = InMaxHitResultsPerTrace;
+		INC_DWORD_STAT(STAT_GRBTraceActorPatches);
+		++ConfigVersion;
+	}
+	return ConfigVersion;
+}
+
+///--@brief 整体配置写入后递增版本号; 由各子类的Configure末尾调用--/
+uint32 AGRBGATA_Trace::MarkFullyConfigured()
+{
+	INC_DWORD_STAT(STAT_GRBTraceActorFullConfigures);
+	return ++ConfigVersion;
+}
+
 
 #pragma region ~ 内部方法 ~
 ///--@brief 为一组命中hit制作 目标数据句柄 并存储它们.--/
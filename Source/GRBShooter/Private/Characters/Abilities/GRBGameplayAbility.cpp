@@ -72,14 +72,57 @@ void UGRBGameplayAbility::OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo
 	}
 }
 
+///--@brief 虚接口: 技能被授予; 实例化的技能在此登记交互Tag对并缓存索引--/
+void UGRBGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	// CDO被所有ASC共用, 不能缓存某一个ASC上的索引
+	if (bCannotActivateWhileInteracting && IsInstantiated() && ActorInfo && InteractingTagPairIndex == INDEX_NONE)
+	{
+		if (UGRBAbilitySystemComponent* const GRBASC = Cast<UGRBAbilitySystemComponent>(ActorInfo->AbilitySystemComponent.Get()))
+		{
+			InteractingTagPairASC = GRBASC;
+			InteractingTagPairIndex = GRBASC->FindOrAddTagPair(InteractingTag, InteractingRemovalTag);
+		}
+	}
+}
+
+///--@brief 虚接口: 技能被移除; 释放授予时登记的交互Tag对--/
+void UGRBGameplayAbility::OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	if (UGRBAbilitySystemComponent* const GRBASC = InteractingTagPairASC.Get())
+	{
+		GRBASC->ReleaseTagPair(InteractingTagPairIndex);
+	}
+	InteractingTagPairASC.Reset();
+	InteractingTagPairIndex = INDEX_NONE;
+
+	Super::OnRemoveAbility(ActorInfo, Spec);
+}
+
+///--@brief 虚接口: 激活前的准备; 这里登记激活预测Key以追踪其确认/拒绝--/
+void UGRBGameplayAbility::PreActivate(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, FOnGameplayAbilityEnded::FDelegate* OnGameplayAbilityEndedDelegate, const FGameplayEventData* TriggerEventData)
+{
+	Super::PreActivate(Handle, ActorInfo, ActivationInfo, OnGameplayAbilityEndedDelegate, TriggerEventData);
+
+	if (UGRBAbilitySystemComponent* const GRBASC = Cast<UGRBAbilitySystemComponent>(ActorInfo->AbilitySystemComponent.Get()))
+	{
+		GRBASC->TracePredictionKey(this, ActivationInfo.GetActivationPredictionKey(), EGRBPredictionKeyUsage::Activation);
+	}
+}
+
 ///--@brief 虚接口： 检查技能发动条件--/
 bool UGRBGameplayAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
 {
 	// 禁用交互时刻释放技能的时候是以检查 交互标签次数是否少于移除交互标签次数
 	if (bCannotActivateWhileInteracting)
 	{
+		// 授予时缓存了索引则只是一次位测试; CDO上检查或非GRB的ASC退化为直接比较层数
 		UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
-		if (ASC->GetTagCount(InteractingTag) > ASC->GetTagCount(InteractingRemovalTag))
+		const bool bHasTagPair = InteractingTagPairIndex != INDEX_NONE && InteractingTagPairASC.Get() == ASC;
+		const bool bIsInteracting = bHasTagPair ? InteractingTagPairASC->IsTagPairActive(InteractingTagPairIndex) : ASC->GetTagCount(InteractingTag) > ASC->GetTagCount(InteractingRemovalTag);
+		if (bIsInteracting)
 		{
 			return false;
 		}
@@ -284,6 +327,10 @@ void UGRBGameplayAbility::SendTargetDataToServer(const FGameplayAbilityTargetDat
 		check(ASC);
 
 		FScopedPredictionWindow ScopedPrediction(ASC, IsPredictingClient());
+		if (UGRBAbilitySystemComponent* const GRBASC = Cast<UGRBAbilitySystemComponent>(ASC))
+		{
+			GRBASC->TracePredictionKey(this, ASC->ScopedPredictionKey, EGRBPredictionKeyUsage::TargetData);
+		}
 
 		FGameplayTag ApplicationTag; // Fixme: where would this be useful?
 		CurrentActorInfo->AbilitySystemComponent->CallServerSetReplicatedTargetData(CurrentSpecHandle,
@@ -5,6 +5,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "Characters/Abilities/GRBInteractableRegistry.h"
 
 bool IGRBInteractable::IsAvailableForInteraction_Implementation(UPrimitiveComponent* InteractionComponent) const
 {
@@ -35,49 +36,39 @@ FSimpleMulticastDelegate* IGRBInteractable::GetTargetCancelInteractionDelegate(U
 
 void IGRBInteractable::RegisterInteracter_Implementation(UPrimitiveComponent* InteractionComponent, AActor* InteractingActor)
 {
-	if (Interacters.Contains(InteractionComponent))
-	{
-		TArray<AActor*>& InteractingActors = Interacters[InteractionComponent];
-		if (!InteractingActors.Contains(InteractingActor))
-		{
-			InteractingActors.Add(InteractingActor);
-		}
-	}
-	else
-	{
-		TArray<AActor*> InteractingActors;
-		InteractingActors.Add(InteractingActor);
-		Interacters.Add(InteractionComponent, InteractingActors);
-	}
+	TArray<TWeakObjectPtr<AActor>>& InteractingActors = Interacters.FindOrAdd(InteractionComponent);
+	// 顺带清掉已销毁的交互者
+	InteractingActors.RemoveAllSwap([](const TWeakObjectPtr<AActor>& WeakActor) { return !WeakActor.IsValid(); }, false);
+	InteractingActors.AddUnique(InteractingActor);
 }
 
 void IGRBInteractable::UnregisterInteracter_Implementation(UPrimitiveComponent* InteractionComponent, AActor* InteractingActor)
 {
-	if (Interacters.Contains(InteractionComponent))
+	if (TArray<TWeakObjectPtr<AActor>>* const InteractingActors = Interacters.Find(InteractionComponent))
 	{
-		TArray<AActor*>& InteractingActors = Interacters[InteractionComponent];
-		InteractingActors.Remove(InteractingActor);
+		InteractingActors->Remove(InteractingActor);
+		if (InteractingActors->Num() == 0)
+		{
+			Interacters.Remove(InteractionComponent);
+		}
 	}
 }
 
 void IGRBInteractable::InteractableCancelInteraction_Implementation(UPrimitiveComponent* InteractionComponent)
 {
-	if (Interacters.Contains(InteractionComponent))
+	TArray<TWeakObjectPtr<AActor>> InteractingActors;
+	if (!Interacters.RemoveAndCopyValue(InteractionComponent, InteractingActors))
 	{
-		FGameplayTagContainer InteractAbilityTagContainer;
-		InteractAbilityTagContainer.AddTag(FGameplayTag::RequestGameplayTag("Ability.Interaction"));
+		return;
+	}
 
-		TArray<AActor*>& InteractingActors = Interacters[InteractionComponent];
-		for (AActor* InteractingActor : InteractingActors)
+	// 取消用的Tag组由注册表缓存, 不再每次取消时构建
+	const FGameplayTagContainer& InteractAbilityTagContainer = UGRBInteractableRegistry::GetInteractionAbilityTags();
+	for (const TWeakObjectPtr<AActor>& WeakInteractingActor : InteractingActors)
+	{
+		if (UAbilitySystemComponent* ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(WeakInteractingActor.Get()))
 		{
-			UAbilitySystemComponent* ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(InteractingActor);
-
-			if (ASC)
-			{
-				ASC->CancelAbilities(&InteractAbilityTagContainer);
-			}
+			ASC->CancelAbilities(&InteractAbilityTagContainer);
 		}
-
-		InteractingActors.Empty();
 	}
 }
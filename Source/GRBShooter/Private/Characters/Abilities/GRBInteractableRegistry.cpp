@@ -0,0 +1,197 @@
+// Copyright 2024 GRB.
+
+
+#include "Characters/Abilities/GRBInteractableRegistry.h"
+#include "Characters/Abilities/GRBAbilitySystemComponent.h"
+#include "Characters/Abilities/GRBInteractable.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interactable Query"), STAT_GRBInteractableQuery, STATGROUP_GRBAbility);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Interactables"), STAT_GRBInteractablesRegistered, STATGROUP_GRBAbility);
+
+static TAutoConsoleVariable<float> CVarInteractCellSize(
+	TEXT("GRB.interact.CellSize"),
+	400.0f,
+	TEXT("Edge length of the uniform grid cells used by the interactable registry. Applied when the grid is empty.")
+);
+
+// 单个静态交互区域最多覆盖的格子数; 超出的按可移动区域线性检查
+static constexpr int32 GMaxCellsPerInteractable = 64;
+
+#pragma region ~ UGRBInteractableRegistry ~
+bool UGRBInteractableRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGRBInteractableRegistry::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_GRBInteractablesRegistered, GetNumInteractables());
+	Grid.Reset();
+	StaticCellRanges.Empty();
+	MovableInteractables.Empty();
+
+	Super::Deinitialize();
+}
+
+UGRBInteractableRegistry* UGRBInteractableRegistry::Get(const UObject* InWorldContextObject)
+{
+	const UWorld* const World = GEngine ? GEngine->GetWorldFromContextObject(InWorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UGRBInteractableRegistry>() : nullptr;
+}
+
+///--@brief 取消交互时要取消的技能Tag组; 只构建一次--/
+const FGameplayTagContainer& UGRBInteractableRegistry::GetInteractionAbilityTags()
+{
+	static const FGameplayTagContainer InteractionAbilityTags(FGameplayTag::RequestGameplayTag(FName("Ability.Interaction")));
+	return InteractionAbilityTags;
+}
+
+///--@brief 登记交互区域; 所属Actor须实现 IGRBInteractable. 已登记时按当前包围盒重新入格--/
+void UGRBInteractableRegistry::RegisterInteractable(UPrimitiveComponent* InInteractionComponent)
+{
+	if (!IsValid(InInteractionComponent) || !InInteractionComponent->GetOwner() || !InInteractionComponent->GetOwner()->Implements<UGRBInteractable>())
+	{
+		return;
+	}
+
+	// 重新登记: 先撤掉旧的位置
+	bool bAlreadyRegistered = false;
+	FInteractableGrid::FCellRange OldRange;
+	if (StaticCellRanges.RemoveAndCopyValue(InInteractionComponent, OldRange))
+	{
+		Grid.Remove(OldRange, InInteractionComponent);
+		bAlreadyRegistered = true;
+	}
+	else if (MovableInteractables.Remove(InInteractionComponent) > 0)
+	{
+		bAlreadyRegistered = true;
+	}
+
+	Grid.SetCellSizeIfEmpty(FMath::Max(CVarInteractCellSize.GetValueOnGameThread(), 50.0f));
+
+	const FInteractableGrid::FCellRange Range = Grid.GetCellRange(InInteractionComponent->Bounds.GetBox());
+	const bool bMovable = InInteractionComponent->Mobility == EComponentMobility::Movable || Range.NumCells() > GMaxCellsPerInteractable;
+	if (bMovable)
+	{
+		MovableInteractables.Add(InInteractionComponent);
+	}
+	else
+	{
+		StaticCellRanges.Add(InInteractionComponent, Range);
+		Grid.Add(Range, InInteractionComponent);
+	}
+
+	if (!bAlreadyRegistered)
+	{
+		INC_DWORD_STAT(STAT_GRBInteractablesRegistered);
+	}
+}
+
+///--@brief 注销交互区域--/
+void UGRBInteractableRegistry::UnregisterInteractable(UPrimitiveComponent* InInteractionComponent)
+{
+	FInteractableGrid::FCellRange Range;
+	if (StaticCellRanges.RemoveAndCopyValue(InInteractionComponent, Range))
+	{
+		Grid.Remove(Range, InInteractionComponent);
+		DEC_DWORD_STAT(STAT_GRBInteractablesRegistered);
+	}
+	else if (MovableInteractables.Remove(InInteractionComponent) > 0)
+	{
+		DEC_DWORD_STAT(STAT_GRBInteractablesRegistered);
+	}
+}
+
+///--@brief 收集范围内当前可交互的区域, 按距离由近到远; 返回个数--/
+int32 UGRBInteractableRegistry::QueryInteractables(const FVector& InLocation, float InRadius, TArray<UPrimitiveComponent*>& OutInteractionComponents) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBInteractableQuery);
+
+	OutInteractionComponents.Reset();
+	TArray<UPrimitiveComponent*, TInlineAllocator<16>> Candidates;
+	GatherCandidates(InLocation, InRadius, Candidates);
+
+	for (UPrimitiveComponent* const Candidate : Candidates)
+	{
+		if (IsAvailable(Candidate))
+		{
+			OutInteractionComponents.Add(Candidate);
+		}
+	}
+
+	OutInteractionComponents.Sort([&InLocation](const UPrimitiveComponent& A, const UPrimitiveComponent& B)
+	{
+		return FVector::DistSquared(A.Bounds.Origin, InLocation) < FVector::DistSquared(B.Bounds.Origin, InLocation);
+	});
+	return OutInteractionComponents.Num();
+}
+
+///--@brief 范围内且处于视锥内(与视线夹角余弦 >= InMinViewDot)最近的可交互区域; 没有则返回空--/
+UPrimitiveComponent* UGRBInteractableRegistry::FindBestInteractable(const FVector& InViewLocation, const FVector& InViewDirection, float InRadius, float InMinViewDot) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBInteractableQuery);
+
+	TArray<UPrimitiveComponent*, TInlineAllocator<16>> Candidates;
+	GatherCandidates(InViewLocation, InRadius, Candidates);
+
+	const FVector ViewDirection = InViewDirection.GetSafeNormal();
+	UPrimitiveComponent* BestComponent = nullptr;
+	float BestDistanceSquared = TNumericLimits<float>::Max();
+	for (UPrimitiveComponent* const Candidate : Candidates)
+	{
+		// 交互区域贴脸时视线方向不可靠, 包围球内一律视为在视锥内
+		const FVector ToCandidate = Candidate->Bounds.Origin - InViewLocation;
+		const float DistanceSquared = ToCandidate.SizeSquared();
+		const bool bInside = DistanceSquared <= FMath::Square(Candidate->Bounds.SphereRadius);
+		if (DistanceSquared >= BestDistanceSquared || (!bInside && FVector::DotProduct(ToCandidate.GetSafeNormal(), ViewDirection) < InMinViewDot))
+		{
+			continue;
+		}
+
+		if (IsAvailable(Candidate))
+		{
+			BestComponent = Candidate;
+			BestDistanceSquared = DistanceSquared;
+		}
+	}
+	return BestComponent;
+}
+
+///--@brief 收集范围内的候选区域(未做可交互性检查, 已去重)--/
+void UGRBInteractableRegistry::GatherCandidates(const FVector& InLocation, float InRadius, TArray<UPrimitiveComponent*, TInlineAllocator<16>>& OutCandidates) const
+{
+	const auto IsInRange = [&InLocation, InRadius](const UPrimitiveComponent* InComponent)
+	{
+		// 以包围球表面计距离, 大件交互物不必走到中心点附近
+		return FVector::Dist(InComponent->Bounds.Origin, InLocation) - InComponent->Bounds.SphereRadius <= InRadius;
+	};
+
+	Grid.ForEachInRange(Grid.GetCellRange(InLocation, InRadius), [&OutCandidates, &IsInRange](UPrimitiveComponent* InComponent)
+	{
+		if (IsInRange(InComponent))
+		{
+			// 跨格的交互区域会在多个格子里出现
+			OutCandidates.AddUnique(InComponent);
+		}
+	});
+
+	for (const TWeakObjectPtr<UPrimitiveComponent>& WeakComponent : MovableInteractables)
+	{
+		UPrimitiveComponent* const Component = WeakComponent.Get();
+		if (Component && IsInRange(Component))
+		{
+			OutCandidates.Add(Component);
+		}
+	}
+}
+
+///--@brief 区域是否仍可交互--/
+bool UGRBInteractableRegistry::IsAvailable(UPrimitiveComponent* InInteractionComponent)
+{
+	AActor* const Owner = InInteractionComponent->GetOwner();
+	return IsValid(Owner) && IGRBInteractable::Execute_IsAvailableForInteraction(Owner, InInteractionComponent);
+}
+#pragma endregion
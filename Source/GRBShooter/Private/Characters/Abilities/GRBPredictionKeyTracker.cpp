@@ -0,0 +1,171 @@
+// Copyright 2024 GRB.
+
+
+#include "Characters/Abilities/GRBPredictionKeyTracker.h"
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GRBAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "GRBShooter/GRBShooter.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Trace/Trace.inl"
+
+static TAutoConsoleVariable<float> CVarPredictionKeyLeakSeconds(
+	TEXT("GRB.prediction.LeakSeconds"),
+	5.0f,
+	TEXT("Seconds a locally created prediction key may stay without being caught up or rejected before it is reported as leaked.")
+);
+
+static TAutoConsoleVariable<bool> CVarPredictionKeyLog(
+	TEXT("GRB.prediction.LogKeys"),
+	false,
+	TEXT("Log creation and resolution of every prediction key created by GRB abilities.")
+);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Prediction Keys Rejected / Min"), STAT_GRBPredictionKeysRejectedPerMinute, STATGROUP_GRBAbility);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Prediction Keys Created / Min"), STAT_GRBPredictionKeysCreatedPerMinute, STATGROUP_GRBAbility);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Prediction Keys Outstanding"), STAT_GRBPredictionKeysOutstanding, STATGROUP_GRBAbility);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Prediction Keys Leaked"), STAT_GRBPredictionKeysLeaked, STATGROUP_GRBAbility);
+
+TRACE_DECLARE_FLOAT_COUNTER(GRBPredictionRejectedPerMinute, TEXT("GRB/Prediction/RejectedPerMinute"));
+TRACE_DECLARE_INT_COUNTER(GRBPredictionOutstandingKeys, TEXT("GRB/Prediction/OutstandingKeys"));
+
+UE_TRACE_CHANNEL_DEFINE(GRBPredictionChannel)
+
+UE_TRACE_EVENT_BEGIN(GRBPrediction, KeyCreated)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int16, Key)
+	UE_TRACE_EVENT_FIELD(int16, BaseKey)
+	UE_TRACE_EVENT_FIELD(uint8, Usage)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Ability)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GRBPrediction, KeyResolved)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int16, Key)
+	UE_TRACE_EVENT_FIELD(bool, Rejected)
+	UE_TRACE_EVENT_FIELD(bool, Leaked)
+	UE_TRACE_EVENT_FIELD(float, LatencyMs)
+UE_TRACE_EVENT_END()
+
+///--@brief 登记一个新的预测Key并挂接结论回调--/
+bool FGRBPredictionKeyTracker::TraceKeyCreated(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, const FPredictionKey& InKey, EGRBPredictionKeyUsage InUsage, double InNow)
+{
+	// 只有本地预测端生成的Key会等到服务端的结论
+	if (!InASC || !InKey.IsLocalClientKey() || OutstandingKeys.Contains(InKey.Current))
+	{
+		return false;
+	}
+
+	FTracedPredictionKey& Traced = OutstandingKeys.Add(InKey.Current);
+	Traced.AbilityName = InAbility ? InAbility->GetClass()->GetFName() : NAME_None;
+	Traced.CreateTime = InNow;
+	Traced.BaseKey = InKey.Base;
+	Traced.Usage = InUsage;
+	RecentCreationTimes.Add(InNow);
+
+	const FString AbilityName = Traced.AbilityName.ToString();
+	UE_TRACE_LOG(GRBPrediction, KeyCreated, GRBPredictionChannel)
+		<< KeyCreated.Cycle(FPlatformTime::Cycles64())
+		<< KeyCreated.Key(InKey.Current)
+		<< KeyCreated.BaseKey(InKey.Base)
+		<< KeyCreated.Usage(static_cast<uint8>(InUsage))
+		<< KeyCreated.Ability(*AbilityName, AbilityName.Len());
+
+	if (CVarPredictionKeyLog.GetValueOnGameThread())
+	{
+		UE_LOG(LogGRBGameplayAbility, Log, TEXT("Prediction key %d created by %s (base %d, usage %d)"), InKey.Current, *AbilityName, InKey.Base, static_cast<int32>(InUsage));
+	}
+
+	// 依赖链: 依赖的Base Key被拒绝时, 引擎会连带拒绝本Key
+	const FPredictionKey::KeyType KeyId = InKey.Current;
+	FPredictionKey MutableKey = InKey;
+	MutableKey.NewRejectedDelegate().BindWeakLambda(InASC, [this, InASC, KeyId]()
+	{
+		OnKeyResolved(KeyId, true, InASC->GetWorld() ? InASC->GetWorld()->GetTimeSeconds() : 0.0);
+	});
+	MutableKey.NewCaughtUpDelegate().BindWeakLambda(InASC, [this, InASC, KeyId]()
+	{
+		OnKeyResolved(KeyId, false, InASC->GetWorld() ? InASC->GetWorld()->GetTimeSeconds() : 0.0);
+	});
+
+	INC_DWORD_STAT(STAT_GRBPredictionKeysOutstanding);
+	return true;
+}
+
+///--@brief 服务端对Key给出结论(确认或拒绝)--/
+void FGRBPredictionKeyTracker::OnKeyResolved(FPredictionKey::KeyType InKey, bool bRejected, double InNow)
+{
+	FTracedPredictionKey Traced;
+	if (!OutstandingKeys.RemoveAndCopyValue(InKey, Traced))
+	{
+		return;
+	}
+	DEC_DWORD_STAT(STAT_GRBPredictionKeysOutstanding);
+
+	const float LatencyMs = static_cast<float>((InNow - Traced.CreateTime) * 1000.0);
+	UE_TRACE_LOG(GRBPrediction, KeyResolved, GRBPredictionChannel)
+		<< KeyResolved.Cycle(FPlatformTime::Cycles64())
+		<< KeyResolved.Key(InKey)
+		<< KeyResolved.Rejected(bRejected)
+		<< KeyResolved.Leaked(false)
+		<< KeyResolved.LatencyMs(LatencyMs);
+
+	if (bRejected)
+	{
+		RecentRejectionTimes.Add(InNow);
+		TRACE_BOOKMARK(TEXT("GRB prediction rejected: %s key %d"), *Traced.AbilityName.ToString(), InKey);
+		UE_LOG(LogGRBGameplayAbility, Verbose, TEXT("Prediction key %d of %s rejected after %.1f ms"), InKey, *Traced.AbilityName.ToString(), LatencyMs);
+	}
+	else if (CVarPredictionKeyLog.GetValueOnGameThread())
+	{
+		UE_LOG(LogGRBGameplayAbility, Log, TEXT("Prediction key %d of %s caught up after %.1f ms"), InKey, *Traced.AbilityName.ToString(), LatencyMs);
+	}
+}
+
+///--@brief 刷新每分钟统计并检查泄漏--/
+bool FGRBPredictionKeyTracker::UpdateSummary(double InNow)
+{
+	TrimOlderThan(RecentCreationTimes, InNow - 60.0);
+	TrimOlderThan(RecentRejectionTimes, InNow - 60.0);
+
+	// 超时仍无结论的Key: 通常是预测窗口被丢弃或依赖链断开, 会一直占着引擎的委托表
+	const double LeakCutoff = InNow - CVarPredictionKeyLeakSeconds.GetValueOnGameThread();
+	for (auto It = OutstandingKeys.CreateIterator(); It; ++It)
+	{
+		if (It.Value().CreateTime < LeakCutoff)
+		{
+			UE_LOG(LogGRBGameplayAbility, Warning, TEXT("Prediction key %d of %s (base %d) has not been caught up or rejected after %.1f s"),
+			       It.Key(), *It.Value().AbilityName.ToString(), It.Value().BaseKey, InNow - It.Value().CreateTime);
+			UE_TRACE_LOG(GRBPrediction, KeyResolved, GRBPredictionChannel)
+				<< KeyResolved.Cycle(FPlatformTime::Cycles64())
+				<< KeyResolved.Key(It.Key())
+				<< KeyResolved.Rejected(false)
+				<< KeyResolved.Leaked(true)
+				<< KeyResolved.LatencyMs(static_cast<float>((InNow - It.Value().CreateTime) * 1000.0));
+			INC_DWORD_STAT(STAT_GRBPredictionKeysLeaked);
+			DEC_DWORD_STAT(STAT_GRBPredictionKeysOutstanding);
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_FLOAT_STAT(STAT_GRBPredictionKeysRejectedPerMinute, RecentRejectionTimes.Num());
+	SET_FLOAT_STAT(STAT_GRBPredictionKeysCreatedPerMinute, RecentCreationTimes.Num());
+	TRACE_COUNTER_SET(GRBPredictionRejectedPerMinute, RecentRejectionTimes.Num());
+	TRACE_COUNTER_SET(GRBPredictionOutstandingKeys, OutstandingKeys.Num());
+
+	return OutstandingKeys.Num() > 0 || RecentCreationTimes.Num() > 0 || RecentRejectionTimes.Num() > 0;
+}
+
+///--@brief 丢弃一分钟以前的时间戳--/
+void FGRBPredictionKeyTracker::TrimOlderThan(TArray<double>& InOutTimes, double InCutoff)
+{
+	// 时间戳按先后追加, 从头找到第一个仍在窗口内的即可
+	int32 FirstKept = 0;
+	while (FirstKept < InOutTimes.Num() && InOutTimes[FirstKept] < InCutoff)
+	{
+		++FirstKept;
+	}
+	InOutTimes.RemoveAt(0, FirstKept, false);
+}
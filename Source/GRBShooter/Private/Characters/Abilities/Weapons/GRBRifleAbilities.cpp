@@ -188,7 +188,9 @@ void UGA_GRBRiflePrimaryInstant::GRBApplyCost_Implementation(const FGameplayAbil
 	{
 		if (!pGRBWeapon->HasInfiniteAmmo())
 		{
-			pGRBWeapon->SetPrimaryClipAmmo(pGRBWeapon->GetPrimaryClipAmmo() - mAmmoCost);
+			// 本地预测端按当前预测窗口记账, 被拒绝时回滚
+			const UAbilitySystemComponent* const ASC = ActorInfo.AbilitySystemComponent.Get();
+			pGRBWeapon->SpendPrimaryClipAmmo(mAmmoCost, ASC ? ASC->ScopedPredictionKey : FPredictionKey());
 		}
 	}
 }
@@ -221,32 +223,11 @@ void UGA_GRBRiflePrimaryInstant::FireBullet()
 					// 仅在第一视角下
 					if (mOwningHero->IsInFirstPersonPerspective())
 					{
-						TEnumAsByte<EGameplayAbilityTargetingLocationType::Type> LocationType = EGameplayAbilityTargetingLocationType::SocketTransform;
-						FTransform LiteralTransform = FTransform();
-						TObjectPtr<AActor> SourceActor = TObjectPtr<AActor>();
-						TObjectPtr<UMeshComponent> SourceComponent = TObjectPtr<UMeshComponent>(Weapon1PMesh);
-						TObjectPtr<UGameplayAbility> SourceAbility = nullptr;
-						FName SourceSocketName = FName("MuzzleFlashSocket");
-
-						FGameplayAbilityTargetingLocationInfo pLocationInfo = FGameplayAbilityTargetingLocationInfo();
-						pLocationInfo.LocationType = LocationType;
-						pLocationInfo.LiteralTransform = LiteralTransform;
-						pLocationInfo.SourceActor = SourceActor;
-						pLocationInfo.SourceComponent = SourceComponent;
-						pLocationInfo.SourceAbility = SourceAbility;
-						pLocationInfo.SourceSocketName = SourceSocketName;
-
-
-						mTraceStartLocation = pLocationInfo;
-						mTraceFromPlayerViewPointg = true;
-						mLineTraceTargetActor->Configure(mTraceStartLocation, mAimingTag, mAimingRemovealTag,
-						                                 FCollisionProfileName(FName("Projectile")), FGameplayTargetDataFilterHandle(), nullptr,
-						                                 FWorldReticleParameters(), false, false,
-						                                 false, false, true,
-						                                 mTraceFromPlayerViewPointg, true, 99999999.0f,
-						                                 mWeaponSpread, mAimingSpreadMod, mFiringSpreadIncrement,
-						                                 mFiringSpreadMax, 1, 1
-						);
+						// 粘性配置: 探查器仍是装备时写入的那份配置就直接开火; 仅当被其他配置方改写过才整体重配
+						if (!mLineTraceTargetActor->IsConfigurationCurrent(mTraceConfigVersion))
+						{
+							ConfigureLineTraceTargetActor();
+						}
 
 						//---------------------------------------------------  ------------------------------------------------
 						//---------------------------------------------------  ------------------------------------------------
@@ -339,11 +320,10 @@ void UGA_GRBRiflePrimaryInstant::HandleTargetData(const FGameplayAbilityTargetDa
 		PlayFireMontage();
 
 		// Functionally equivalent. Container path does have an insignificant couple more function calls.
-		FSoftObjectPath SoftObjectPaths_Actor1 = FSoftObjectPath(TEXT("/Script/Engine.Blueprint'/Game/GRBShooter/Weapons/Rifle/GE_RifleDamage.GE_RifleDamage_C'"));
-		UClass* pBP_RifleDamageGE = UAssetManager::GetStreamableManager().LoadSynchronous<UClass>(SoftObjectPaths_Actor1);
-		if (pBP_RifleDamageGE)
+		// 伤害BUFF已在缓存阶段解析好, 逐发不再同步加载
+		if (mDamageEffectClass)
 		{
-			const FGameplayEffectSpecHandle& RifleDamageGESpecHandle = UGameplayAbility::MakeOutgoingGameplayEffectSpec(pBP_RifleDamageGE, 1);
+			const FGameplayEffectSpecHandle& RifleDamageGESpecHandle = UGameplayAbility::MakeOutgoingGameplayEffectSpec(mDamageEffectClass, 1);
 			const FGameplayTag& CauseTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
 			const float& Magnitude = mBulletDamage;
 			const FGameplayEffectSpecHandle& TheBuffToApply = UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(RifleDamageGESpecHandle, CauseTag, Magnitude);
@@ -356,7 +336,7 @@ void UGA_GRBRiflePrimaryInstant::HandleTargetData(const FGameplayAbilityTargetDa
 			const FHitResult& HitResultApply = UAbilitySystemBlueprintLibrary::GetHitResultFromTargetData(InTargetDataHandle, 0);
 			UAbilitySystemBlueprintLibrary::EffectContextAddHitResult(ContextHandle, HitResultApply, Reset);
 
-			const FGameplayTag& CueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.Rifle.Fire"));
+			const FGameplayTag& CueTag = mFireCueTag;
 			const FGameplayCueParameters CueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, ContextHandle,
 			                                                                                                       FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
 			                                                                                                       FGameplayTagContainer(), FVector::ZeroVector, FVector::ZeroVector,
@@ -380,44 +360,18 @@ void UGA_GRBRiflePrimaryInstant::PlayFireMontage()
 
 	if (GetAbilitySystemComponentFromActorInfo()->HasMatchingGameplayTag(mAimingTag) && !GetAbilitySystemComponentFromActorInfo()->HasMatchingGameplayTag(mAimingRemovealTag))
 	{
-		if (UAnimMontage* pMontageAsset = LoadObject<UAnimMontage>(mOwningHero, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/FPP_RifleAimFire_Montage.FPP_RifleAimFire_Montage'")))
+		if (UAnimMontage* pMontageAsset = mAimFireMontage)
 		{
-			UGRBAT_PlayMontageForMeshAndWaitForEvent* Node = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayMontageForMeshAndWaitForEvent(
-				this,
-				FName("None"),
-				mOwningHero->GetFirstPersonMesh(),
-				pMontageAsset,
-				FGameplayTagContainer(),
-				1,
-				FName("None"),
-				false,
-				1,
-				false,
-				-1,
-				-1
-			);
-			Node->ReadyForActivation();
+			// 连发时复用同一个任务重播, 不再每发新建任务与注册委托
+			mFireMontageTask = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(mFireMontageTask, this, mOwningHero->GetFirstPersonMesh(), pMontageAsset, 1, FName("None"), false, false);
 		}
 	}
 	else
 	{
-		if (UAnimMontage* pMontageAsset = LoadObject<UAnimMontage>(mOwningHero, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/HerroFPP_RifleFire_Montage.HerroFPP_RifleFire_Montage'")))
+		if (UAnimMontage* pMontageAsset = mFireMontage)
 		{
-			UGRBAT_PlayMontageForMeshAndWaitForEvent* Node = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayMontageForMeshAndWaitForEvent(
-				this,
-				FName("None"),
-				mOwningHero->GetFirstPersonMesh(),
-				pMontageAsset,
-				FGameplayTagContainer(),
-				1,
-				FName("None"),
-				false,
-				1,
-				false,
-				-1,
-				-1
-			);
-			Node->ReadyForActivation();
+			// 连发时复用同一个任务重播, 不再每发新建任务与注册委托
+			mFireMontageTask = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(mFireMontageTask, this, mOwningHero->GetFirstPersonMesh(), pMontageAsset, 1, FName("None"), false, false);
 		}
 	}
 }
@@ -430,6 +384,7 @@ void UGA_GRBRiflePrimaryInstant::CheckAndSetupCacheables()
 	if (!IsValid(mSourceWeapon))
 	{
 		mSourceWeapon = Cast<AGRBWeapon>(GetCurrentSourceObject());
+		ApplyWeaponFireParams();
 	}
 	if (!IsValid(Weapon1PMesh))
 	{
@@ -455,9 +410,77 @@ void UGA_GRBRiflePrimaryInstant::CheckAndSetupCacheables()
 	if (!IsValid(mLineTraceTargetActor))
 	{
 		mLineTraceTargetActor = mSourceWeapon->GetLineTraceTargetActor();
+		ConfigureLineTraceTargetActor();
 	}
 }
 
+///--@brief 读取武器定义烘焙好的开火参数; 未配置武器定义时沿用技能自身默认值--/
+void UGA_GRBRiflePrimaryInstant::ApplyWeaponFireParams()
+{
+	const FGRBWeaponFireParams* const FireParams = IsValid(mSourceWeapon) ? mSourceWeapon->GetFireParams() : nullptr;
+	if (FireParams)
+	{
+		mTraceParams = FireParams->PrimaryTrace;
+		mAmmoCost = FireParams->AmmoCost;
+		mBulletDamage = FireParams->Damage;
+		mWeaponSpread = mTraceParams.BaseSpread;
+		mAimingSpreadMod = mTraceParams.AimingSpreadMod;
+		mFiringSpreadIncrement = mTraceParams.TargetingSpreadIncrement;
+		mFiringSpreadMax = mTraceParams.TargetingSpreadMax;
+		mTraceFromPlayerViewPointg = mTraceParams.bTraceFromPlayerViewPoint;
+		mAimingTag = mTraceParams.AimingTag;
+		mAimingRemovealTag = mTraceParams.AimingRemovalTag;
+		mDamageEffectClass = FireParams->DamageEffectClass;
+		mFireMontage = FireParams->FireMontage;
+		mAimFireMontage = FireParams->AimFireMontage;
+		mFireCueTag = FireParams->FireCueTag;
+	}
+	else
+	{
+		mTraceParams = FGRBWeaponTraceParams();
+		mTraceParams.MaxRange = 99999999.0f;
+		mTraceParams.bTraceFromPlayerViewPoint = mTraceFromPlayerViewPointg;
+		mTraceParams.bUseAimingSpreadMod = true;
+		mTraceParams.BaseSpread = mWeaponSpread;
+		mTraceParams.AimingSpreadMod = mAimingSpreadMod;
+		mTraceParams.TargetingSpreadIncrement = mFiringSpreadIncrement;
+		mTraceParams.TargetingSpreadMax = mFiringSpreadMax;
+		mTraceParams.AimingTag = mAimingTag;
+		mTraceParams.AimingRemovalTag = mAimingRemovealTag;
+	}
+
+	// 武器定义里没配的资产按原有路径各加载一次
+	if (!mDamageEffectClass)
+	{
+		mDamageEffectClass = UAssetManager::GetStreamableManager().LoadSynchronous<UClass>(FSoftObjectPath(TEXT("/Script/Engine.Blueprint'/Game/GRBShooter/Weapons/Rifle/GE_RifleDamage.GE_RifleDamage_C'")));
+	}
+	if (!mFireMontage)
+	{
+		mFireMontage = LoadObject<UAnimMontage>(nullptr, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/HerroFPP_RifleFire_Montage.HerroFPP_RifleFire_Montage'"));
+	}
+	if (!mAimFireMontage)
+	{
+		mAimFireMontage = LoadObject<UAnimMontage>(nullptr, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/FPP_RifleAimFire_Montage.FPP_RifleAimFire_Montage'"));
+	}
+	if (!mFireCueTag.IsValid())
+	{
+		mFireCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.Rifle.Fire"));
+	}
+}
+
+///--@brief 装备后一次性配置射线探查器; 之后逐发开火不再重新Configure--/
+void UGA_GRBRiflePrimaryInstant::ConfigureLineTraceTargetActor()
+{
+	if (!IsValid(mLineTraceTargetActor) || !IsValid(mSourceWeapon))
+	{
+		return;
+	}
+
+	// 只在第一视角开火, 起点固定为1P枪皮的枪口
+	mTraceStartLocation = mTraceParams.MakeMuzzleLocation(mSourceWeapon->GetWeaponMesh1P());
+	mTraceConfigVersion = mTraceParams.ConfigureLineTrace(mLineTraceTargetActor, mTraceStartLocation);
+}
+
 //---------------------------------------------------  ------------------------------------------------
 //---------------------------------------------------  ------------------------------------------------
 
@@ -582,6 +605,13 @@ void UGA_GRBRiflePrimary::CheckAndSetupCacheables()
 		if (AGRBWeapon* const pCastGRBWeapon = Cast<AGRBWeapon>(GetCurrentSourceObject()))
 		{
 			m_SourceWeapon = pCastGRBWeapon;
+
+			// 射击间隔与弹耗以武器定义为准
+			if (const FGRBWeaponFireParams* const FireParams = m_SourceWeapon->GetFireParams())
+			{
+				m_TimeBetweenShot = FireParams->TimeBetweenShots;
+				m_AmmoCost = FireParams->AmmoCost;
+			}
 		}
 	}
 
@@ -18,14 +18,16 @@
 #include "Characters/Abilities/GRBGATA_SphereTrace.h"
 #include "Characters/Abilities/AbilityTasks/GRBAT_PlayMontageForMeshAndWaitForEvent.h"
 #include "Characters/Abilities/AbilityTasks/GRBAT_ServerWaitForClientTargetData.h"
-#include "Characters/Abilities/AbilityTasks/GRBAT_WaitChangeFOV.h"
+#include "Characters/GRBFOVAnimatorComponent.h"
 #include "Characters/Abilities/AbilityTasks/GRBAT_WaitDelayOneFrame.h"
 #include "Characters/Abilities/AbilityTasks/GRBAT_WaitTargetDataUsingActor.h"
 #include "Engine/AssetManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "TimerManager.h"
 #include "Player/GRBPlayerController.h"
 #include "Weapons/GRBProjectile.h"
+#include "Weapons/GRBProjectileManagerSubsystem.h"
 #include "Weapons/GRBWeapon.h"
 #include "UI/GRBHUDReticle.h"
 
@@ -168,7 +170,9 @@ void UGA_GRBRocketLauncherPrimaryInstant::GRBApplyCost_Implementation(const FGam
 	{
 		if (!pGRBWeapon->HasInfiniteAmmo())
 		{
-			pGRBWeapon->SetPrimaryClipAmmo(pGRBWeapon->GetPrimaryClipAmmo() - mAmmoCost);
+			// 本地预测端按当前预测窗口记账, 被拒绝时回滚
+			const UAbilitySystemComponent* const ASC = ActorInfo.AbilitySystemComponent.Get();
+			pGRBWeapon->SpendPrimaryClipAmmo(mAmmoCost, ASC ? ASC->ScopedPredictionKey : FPredictionKey());
 		}
 	}
 }
@@ -189,39 +193,8 @@ void UGA_GRBRocketLauncherPrimaryInstant::FireRocket()
 				/** 组织并构建可复用的射线类型 场景探查器*/
 				if (IsValid(mSourceWeapon))
 				{
-					TEnumAsByte<EGameplayAbilityTargetingLocationType::Type> LocationType = EGameplayAbilityTargetingLocationType::SocketTransform;
-					FTransform LiteralTransform = FTransform();
-					TObjectPtr<AActor> SourceActor = TObjectPtr<AActor>();
-					TObjectPtr<UGameplayAbility> SourceAbility = nullptr;
-					FName SourceSocketName = FName("MuzzleFlashSocket");
-					FGameplayAbilityTargetingLocationInfo pLocationInfo = FGameplayAbilityTargetingLocationInfo();
-					pLocationInfo.LocationType = LocationType;
-					pLocationInfo.LiteralTransform = LiteralTransform;
-					pLocationInfo.SourceActor = SourceActor;
-					pLocationInfo.SourceAbility = SourceAbility;
-					pLocationInfo.SourceSocketName = SourceSocketName;
-
-					if (mOwningHero->IsInFirstPersonPerspective()) // 仅在第一视角下
-					{
-						pLocationInfo.SourceComponent = TObjectPtr<UMeshComponent>(Weapon1PMesh);
-						mTraceStartLocation = pLocationInfo;
-						mTraceFromPlayerViewPointg = true;
-					}
-					else if (!mOwningHero->IsInFirstPersonPerspective()) // 仅在第三视角下
-					{
-						pLocationInfo.SourceComponent = TObjectPtr<UMeshComponent>(Weapon3PMesh);
-						mTraceStartLocation = pLocationInfo;
-						mTraceFromPlayerViewPointg = false;
-					}
-
-					mLineTraceTargetActor->Configure(mTraceStartLocation, FGameplayTag::EmptyTag, FGameplayTag::EmptyTag,
-					                                 FCollisionProfileName(FName("Projectile")), FGameplayTargetDataFilterHandle(), nullptr,
-					                                 FWorldReticleParameters(), false, false,
-					                                 false, false, true,
-					                                 mTraceFromPlayerViewPointg, false, 99999999.0f,
-					                                 0, 0, 0,
-					                                 0, 1, 1
-					);
+					// 粘性配置: 常规情况下探查器配置未变, 逐发不做任何配置
+					UpdateTracePerspective();
 
 					//---------------------------------------------------  ------------------------------------------------
 					//---------------------------------------------------  ------------------------------------------------
@@ -323,7 +296,22 @@ void UGA_GRBRocketLauncherPrimaryInstant::HandleTargetData(const FGameplayAbilit
 		const FHitResult& TraceHit = UAbilitySystemBlueprintLibrary::GetHitResultFromTargetData(InTargetDataHandle, 0);
 		const FRotator& LookAtRotation = UKismetMathLibrary::FindLookAtRotation(TraceHit.TraceStart, TraceHit.Location);
 		//
-		if (mOwningHero->HasAuthority())
+		if (mOwningHero->HasAuthority() && mUseLightweightProjectile)
+		{
+			// 轻量弹丸: 只生成一条模拟数据, 由管理器批量积分/扫掠, 仅复制出生事件
+			if (UGRBProjectileManagerSubsystem* const ProjectileManager = GetWorld()->GetSubsystem<UGRBProjectileManagerSubsystem>())
+			{
+				FGRBProjectileSpawnParams SpawnParams;
+				SpawnParams.Origin = TraceHit.TraceStart;
+				SpawnParams.Direction = LookAtRotation.Vector();
+				SpawnParams.Instigator = mOwningHero;
+				SpawnParams.InstigatorASC = Cast<UGRBAbilitySystemComponent>(GetAbilitySystemComponentFromActorInfo());
+				SpawnParams.EffectContainerSpec = GRBGEContainerSpecPak;
+				SpawnParams.ImpactCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.RocketLauncher.Impact"));
+				ProjectileManager->SpawnProjectile(SpawnParams);
+			}
+		}
+		else if (mOwningHero->HasAuthority())
 		{
 			FSoftObjectPath SoftObjectPaths_Actor1 = FSoftObjectPath(TEXT("/Script/Engine.Blueprint'/Game/GRBShooter/Weapons/RocketLauncher/BP_RocketLauncherProjectile.BP_RocketLauncherProjectile_C'"));
 			UClass* GRBProjectileBP = UAssetManager::GetStreamableManager().LoadSynchronous<UClass>(SoftObjectPaths_Actor1);
@@ -336,6 +324,14 @@ void UGA_GRBRocketLauncherPrimaryInstant::HandleTargetData(const FGameplayAbilit
 			PSpawnTrans.SetLocation(SpawnLoc);
 			PSpawnTrans.SetRotation(FQuat(SpawnRot));
 			AGRBProjectile* const SpawnedGRBProjectile = mOwningHero->GetWorld()->SpawnActorDeferred<AGRBProjectile>(GRBProjectileBP, PSpawnTrans, mOwningHero, mOwningHero, ESpawnActorCollisionHandlingMethod::AlwaysSpawn, ESpawnActorScaleMethod::OverrideRootScale);
+			// 开火者ASC与开火Cue参数在生成时一并传入, 弹丸BeginPlay不再自行查找
+			SpawnedGRBProjectile->mGRBASC = Cast<UGRBAbilitySystemComponent>(GetAbilitySystemComponentFromActorInfo());
+			SpawnedGRBProjectile->mFireCueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, FGameplayEffectContextHandle(),
+			                                                                                                    FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
+			                                                                                                    FGameplayTagContainer(), SpawnLoc, SpawnRot.Vector(),
+			                                                                                                    mOwningHero, nullptr, nullptr,
+			                                                                                                    nullptr, 1, 1,
+			                                                                                                    nullptr, false);
 			SpawnedGRBProjectile->FinishSpawning(PSpawnTrans);
 		}
 
@@ -398,42 +394,16 @@ void UGA_GRBRocketLauncherPrimaryInstant::PlayFireMontage()
 	{
 		if (UAnimMontage* pMontageAsset = LoadObject<UAnimMontage>(mOwningHero, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/FPP_LauncherAimFire_Montage.FPP_LauncherAimFire_Montage'")))
 		{
-			UGRBAT_PlayMontageForMeshAndWaitForEvent* Node = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayMontageForMeshAndWaitForEvent(
-				this,
-				FName("None"),
-				mOwningHero->GetFirstPersonMesh(),
-				pMontageAsset,
-				FGameplayTagContainer(),
-				1,
-				FName("None"),
-				false,
-				1,
-				false,
-				-1,
-				-1
-			);
-			Node->ReadyForActivation();
+			// 连发时复用同一个任务重播, 不再每发新建任务与注册委托
+			mFireMontageTask = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(mFireMontageTask, this, mOwningHero->GetFirstPersonMesh(), pMontageAsset, 1, FName("None"), false, false);
 		}
 	}
 	else
 	{
 		if (UAnimMontage* pMontageAsset = LoadObject<UAnimMontage>(mOwningHero, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/HeroFPP_LauncherFire_Montage.HeroFPP_LauncherFire_Montage'")))
 		{
-			UGRBAT_PlayMontageForMeshAndWaitForEvent* Node = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayMontageForMeshAndWaitForEvent(
-				this,
-				FName("None"),
-				mOwningHero->GetFirstPersonMesh(),
-				pMontageAsset,
-				FGameplayTagContainer(),
-				1,
-				FName("None"),
-				false,
-				1,
-				false,
-				-1,
-				-1
-			);
-			Node->ReadyForActivation();
+			// 连发时复用同一个任务重播, 不再每发新建任务与注册委托
+			mFireMontageTask = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(mFireMontageTask, this, mOwningHero->GetFirstPersonMesh(), pMontageAsset, 1, FName("None"), false, false);
 		}
 	}
 }
@@ -470,9 +440,64 @@ void UGA_GRBRocketLauncherPrimaryInstant::CheckAndSetupCacheables()
 	if (!IsValid(mLineTraceTargetActor))
 	{
 		mLineTraceTargetActor = mSourceWeapon->GetLineTraceTargetActor();
+		ConfigureLineTraceTargetActor();
 	}
 }
 
+///--@brief 装备后一次性配置射线探查器; 之后逐发开火不再重新Configure--/
+void UGA_GRBRocketLauncherPrimaryInstant::ConfigureLineTraceTargetActor()
+{
+	if (!IsValid(mLineTraceTargetActor) || !IsValid(mSourceWeapon))
+	{
+		return;
+	}
+
+	if (const FGRBWeaponFireParams* const FireParams = mSourceWeapon->GetFireParams())
+	{
+		mTraceParams = FireParams->PrimaryTrace;
+		mAmmoCost = FireParams->AmmoCost;
+		mRocketDamage = FireParams->Damage;
+	}
+	else
+	{
+		// 未配置武器定义: 无扩散, 第一视角从视角摄像机Trace
+		mTraceParams = FGRBWeaponTraceParams();
+		mTraceParams.MaxRange = 99999999.0f;
+		mTraceParams.bTraceFromPlayerViewPoint = true;
+	}
+
+	// 按当前视角写入起点; 第三视角一律从枪口Trace
+	mbTraceConfiguredFirstPerson = !IsValid(mOwningHero) || mOwningHero->IsInFirstPersonPerspective();
+	mTraceStartLocation = mTraceParams.MakeMuzzleLocation(mbTraceConfiguredFirstPerson ? Weapon1PMesh : Weapon3PMesh);
+	mTraceFromPlayerViewPointg = mbTraceConfiguredFirstPerson && mTraceParams.bTraceFromPlayerViewPoint;
+
+	FGRBWeaponTraceParams PerspectiveParams = mTraceParams;
+	PerspectiveParams.bTraceFromPlayerViewPoint = mTraceFromPlayerViewPointg;
+	mTraceConfigVersion = PerspectiveParams.ConfigureLineTrace(mLineTraceTargetActor, mTraceStartLocation);
+}
+
+///--@brief 探查器配置被改写过则整体重配; 否则仅在视角切换后修补起点与是否从视角摄像机Trace--/
+void UGA_GRBRocketLauncherPrimaryInstant::UpdateTracePerspective()
+{
+	// 整体重配时已按当前视角写入起点
+	if (!mLineTraceTargetActor->IsConfigurationCurrent(mTraceConfigVersion))
+	{
+		ConfigureLineTraceTargetActor();
+		return;
+	}
+
+	const bool bFirstPerson = mOwningHero->IsInFirstPersonPerspective();
+	if (bFirstPerson == mbTraceConfiguredFirstPerson)
+	{
+		return;
+	}
+
+	mbTraceConfiguredFirstPerson = bFirstPerson;
+	mTraceStartLocation = mTraceParams.MakeMuzzleLocation(bFirstPerson ? Weapon1PMesh : Weapon3PMesh);
+	mTraceFromPlayerViewPointg = bFirstPerson && mTraceParams.bTraceFromPlayerViewPoint;
+	mTraceConfigVersion = mLineTraceTargetActor->PatchStartLocation(mTraceStartLocation, mTraceFromPlayerViewPointg);
+}
+
 UGA_GRBRocketLauncherPrimary::UGA_GRBRocketLauncherPrimary()
 {
 	// 本地预测：（Local Predicted）本地预测是指技能将立即在客户端执行，执行过程中不会询问服务端的正确与否，但是同时服务端也起着决定性的作用，如果服务端的技能执行失败了，客户端的技能也会随之停止并“回滚”。如果服务端和客户端执行的结果不矛盾，客户端会执行的非常流畅无延时。如果技能需要实时响应，可以考虑用这种预测模式。下文会着重介绍这个策略。
@@ -584,6 +609,13 @@ void UGA_GRBRocketLauncherPrimary::CheckAndSetupCacheables()
 		if (AGRBWeapon* const pCastGRBWeapon = Cast<AGRBWeapon>(GetCurrentSourceObject()))
 		{
 			m_SourceWeapon = pCastGRBWeapon;
+
+			// 射击间隔与弹耗以武器定义为准
+			if (const FGRBWeaponFireParams* const FireParams = m_SourceWeapon->GetFireParams())
+			{
+				m_TimeBetweenShot = FireParams->TimeBetweenShots;
+				m_AmmoCost = FireParams->AmmoCost;
+			}
 		}
 	}
 
@@ -738,8 +770,11 @@ void UGA_GRBRocketLauncherSecondary::ActivateAbility(const FGameplayAbilitySpecH
 	mGE_AimingBuffHandle = AppliedBuffHandle;
 
 	// 放大视场角
-	m1PZoomInTask = UGRBAT_WaitChangeFOV::WaitChangeFOV(this, FName("None"), mOwningHero->GetFirstPersonCamera(), mTargeting1PFOV, 0.1f, nullptr);
-	m1PZoomInTask->ReadyForActivation();
+	// 放大无需等待结果, 直接交给FOV动画器, 不创建任务
+	if (UGRBFOVAnimatorComponent* const FOVAnimator = UGRBFOVAnimatorComponent::FindOrAddFOVAnimator(mOwningHero))
+	{
+		FOVAnimator->StartFOVChange(mOwningHero->GetFirstPersonCamera(), mTargeting1PFOV, 0.1f, nullptr);
+	}
 	mOwningHero->SetThirdPersonCameraBoom(100.0f);
 
 	// 在索敌瞄准时候同时发动ADS瞄准请求, 勒令运动组件结合运动队列迟滞运动
@@ -812,14 +847,11 @@ void UGA_GRBRocketLauncherSecondary::EndAbility(const FGameplayAbilitySpecHandle
 	UGameplayAbility::BP_RemoveGameplayEffectFromOwnerWithHandle(mGE_AimingBuffHandle, -1);
 	UGameplayAbility::BP_RemoveGameplayEffectFromOwnerWithHandle(mGE_AimingRemovalBuffHandle, -1);
 
-	// 视场角复位处理
-	if (IsValid(m1PZoomInTask))
-	{
-		m1PZoomInTask->EndTask();
-	}
-	if (IsValid(m1PZoomResetTask))
+	// 视场角复位处理; 先注销复位回调再打断进行中的插值, 以免打断广播重入结束技能或之后覆盖掉下面的复位值
+	ClearZoomReset();
+	if (UGRBFOVAnimatorComponent* const FOVAnimator = mOwningHero->FindComponentByClass<UGRBFOVAnimatorComponent>())
 	{
-		m1PZoomResetTask->EndTask();
+		FOVAnimator->StopFOVChange();
 	}
 	mOwningHero->GetFirstPersonCamera()->SetFieldOfView(90);
 	mOwningHero->SetThirdPersonCameraBoom(300.f);
@@ -858,7 +890,9 @@ void UGA_GRBRocketLauncherSecondary::GRBApplyCost_Implementation(const FGameplay
 	{
 		if (!pGRBWeapon->HasInfiniteAmmo())
 		{
-			pGRBWeapon->SetPrimaryClipAmmo(pGRBWeapon->GetPrimaryClipAmmo() - mAmmoCost);
+			// 本地预测端按当前预测窗口记账, 被拒绝时回滚
+			const UAbilitySystemComponent* const ASC = ActorInfo.AbilitySystemComponent.Get();
+			pGRBWeapon->SpendPrimaryClipAmmo(mAmmoCost, ASC ? ASC->ScopedPredictionKey : FPredictionKey());
 		}
 	}
 }
@@ -874,58 +908,20 @@ void UGA_GRBRocketLauncherSecondary::StartTargeting()
 		// 预配置可复用的球型探查器
 		if (IsValid(mSourceWeapon))
 		{
-			if (mOwningHero->IsInFirstPersonPerspective())
+			// 粘性配置: 配置被其他配置方改写过才整体重配; 否则只修补视角相关的起点与按残余弹量裁剪的命中上限
+			const bool bFirstPerson = mOwningHero->IsInFirstPersonPerspective();
+			if (!mSphereTraceTargetActor->IsConfigurationCurrent(mTraceConfigVersion))
 			{
-				FGameplayAbilityTargetingLocationInfo NewLocationInfo = FGameplayAbilityTargetingLocationInfo();
-				NewLocationInfo.LocationType = EGameplayAbilityTargetingLocationType::SocketTransform;
-				NewLocationInfo.LiteralTransform = FTransform();
-				NewLocationInfo.SourceActor = nullptr;
-				NewLocationInfo.SourceComponent = Weapon1PMesh;
-				NewLocationInfo.SourceAbility = nullptr;
-				NewLocationInfo.SourceSocketName = FName("MuzzleFlashSocket");
-				mTraceStartLocation = NewLocationInfo;
-
-				mTraceFromPlayerViewPointg = true;
+				ConfigureSphereTraceTargetActor();
 			}
-			else if (!mOwningHero->IsInFirstPersonPerspective())
+			else if (bFirstPerson != mbTraceConfiguredFirstPerson)
 			{
-				FGameplayAbilityTargetingLocationInfo NewLocationInfo = FGameplayAbilityTargetingLocationInfo();
-				NewLocationInfo.LocationType = EGameplayAbilityTargetingLocationType::SocketTransform;
-				NewLocationInfo.LiteralTransform = FTransform();
-				NewLocationInfo.SourceActor = nullptr;
-				NewLocationInfo.SourceComponent = Weapon3PMesh;
-				NewLocationInfo.SourceAbility = nullptr;
-				NewLocationInfo.SourceSocketName = FName("MuzzleFlashSocket");
-				mTraceStartLocation = NewLocationInfo;
-
-				mTraceFromPlayerViewPointg = false;
+				mbTraceConfiguredFirstPerson = bFirstPerson;
+				mTraceStartLocation = mTraceParams.MakeMuzzleLocation(bFirstPerson ? Weapon1PMesh : Weapon3PMesh);
+				mTraceFromPlayerViewPointg = bFirstPerson;
+				mTraceConfigVersion = mSphereTraceTargetActor->PatchStartLocation(mTraceStartLocation, mTraceParams.bTraceFromPlayerViewPoint);
 			}
-
-			const FGameplayTag& AimingTag = FGameplayTag::EmptyTag;
-			const FGameplayTag& AimingRemovalTag = FGameplayTag::EmptyTag;
-			const FCollisionProfileName& ProfileName = FCollisionProfileName(FName("Projectile"));
-			const FGameplayTargetDataFilterHandle& FilterHandle = FGameplayTargetDataFilterHandle();
-			const TSubclassOf<AGameplayAbilityWorldReticle>& ReticleClass = (UAssetManager::GetStreamableManager().LoadSynchronous<UClass>(FSoftObjectPath(TEXT("/Script/Engine.Blueprint'/Game/GRBShooter/Characters/Shared/Targeting/BP_SingleTargetReticle.BP_SingleTargetReticle_C'"))));
-			const FWorldReticleParameters& WorldReticleParameters = FWorldReticleParameters();
-			const bool& IgnoreBlockingHits = false;
-			const bool& ShouldProduceTargetDataOnServer = false;
-			const bool& UsePersisitentHitResults = true;
-			const bool& OpenDebug = false;
-			const bool& TraceAffectsAimPitch = true;
-			const bool& TraceFromPlayerViewPoint = true;
-			const bool& UseAimingSpreadMod = false;
-			const float& MaxDetectRange = mMaxRange;
-			const float& TraceSphereRadius = 32.0f;
-			const float& BaseTargetingSpread = 0;
-			const float& AimingSpreadMod = 0;
-			const float& TargetingSpreadIncreasement = 0;
-			const float& TargetingSpreadMax = 0;
-			const int32& MaxHitResultsPerTrace = FMath::Min(mSourceWeapon->GetPrimaryClipAmmo(), mMaxTargets);
-			const int32& NumberOfTraces = 1;
-			mSphereTraceTargetActor->Configure(mTraceStartLocation, AimingTag, AimingRemovalTag, ProfileName, FilterHandle, (ReticleClass), WorldReticleParameters, IgnoreBlockingHits,
-			                                   ShouldProduceTargetDataOnServer, UsePersisitentHitResults, OpenDebug, TraceAffectsAimPitch, TraceFromPlayerViewPoint, UseAimingSpreadMod, MaxDetectRange,
-			                                   TraceSphereRadius, BaseTargetingSpread, AimingSpreadMod, TargetingSpreadIncreasement, TargetingSpreadMax, MaxHitResultsPerTrace, 1
-			);
+			mTraceConfigVersion = mSphereTraceTargetActor->PatchMaxHitResults(FMath::Min(mSourceWeapon->GetPrimaryClipAmmo(), mMaxTargets));
 
 			/**
 			 * 因为是UserConfirmed 模式,
@@ -950,12 +946,25 @@ void UGA_GRBRocketLauncherSecondary::ManuallyKillInstantGA()
 
 void UGA_GRBRocketLauncherSecondary::OnManuallyStopRocketSearch(float InTimeHeld)
 {
-	// 复位FOV
-	const float& HeroOrigin1PFOV = 90.0f;
-	UGRBAT_WaitChangeFOV* const WaitChangeFOVNode = UGRBAT_WaitChangeFOV::WaitChangeFOV(this, FName("None"), mOwningHero->GetFirstPersonCamera(), HeroOrigin1PFOV, 0.05f, nullptr);
-	WaitChangeFOVNode->GetOnTargetFOVReached().AddUniqueDynamic(this, &UGA_GRBRocketLauncherSecondary::ManuallyKillInstantGA);
-	WaitChangeFOVNode->ReadyForActivation();
-	m1PZoomResetTask = WaitChangeFOVNode;
+	// 复位FOV; 直接交给FOV动画器, 不创建任务. 复位结束后结束技能
+	const float HeroOrigin1PFOV = 90.0f;
+	const float ZoomResetDuration = 0.05f;
+	ClearZoomReset();
+	UGRBFOVAnimatorComponent* const FOVAnimator = UGRBFOVAnimatorComponent::FindOrAddFOVAnimator(mOwningHero);
+	if (FOVAnimator)
+	{
+		m1PZoomResetChangeId = FOVAnimator->StartFOVChange(mOwningHero->GetFirstPersonCamera(), HeroOrigin1PFOV, ZoomResetDuration, nullptr);
+	}
+	if (FOVAnimator && FOVAnimator->IsChangingFOV())
+	{
+		// 本地相机推进中, 等本段插值结束
+		m1PZoomResetFinishedHandle = FOVAnimator->OnFOVChangeFinished.AddUObject(this, &UGA_GRBRocketLauncherSecondary::OnZoomResetFinished);
+	}
+	else
+	{
+		// 服务端上动画器已直接到位; 仍按复位时长结束技能, 与客户端的结束时机保持一致
+		GetWorld()->GetTimerManager().SetTimer(m1PZoomResetTimerHandle, this, &UGA_GRBRocketLauncherSecondary::ManuallyKillInstantGA, ZoomResetDuration, false);
+	}
 
 	// 应用 一张BUFF来添加移除ADSTag;
 	// 这张BUFF是GE_RocketLauncherAimingRemoval
@@ -964,6 +973,37 @@ void UGA_GRBRocketLauncherSecondary::OnManuallyStopRocketSearch(float InTimeHeld
 	mGE_AimingRemovalBuffHandle = TheBuffWillApply;
 }
 
+///--@brief 复位FOV的插值结束(到达或被打断), 结束技能--/
+void UGA_GRBRocketLauncherSecondary::OnZoomResetFinished(uint32 InChangeId, bool bReachedTarget)
+{
+	if (InChangeId != m1PZoomResetChangeId)
+	{
+		return;
+	}
+
+	// 被其他插值打断时也结束技能, 否则技能会一直挂着
+	ClearZoomReset();
+	ManuallyKillInstantGA();
+}
+
+///--@brief 注销复位FOV的结束回调与计时--/
+void UGA_GRBRocketLauncherSecondary::ClearZoomReset()
+{
+	if (m1PZoomResetFinishedHandle.IsValid())
+	{
+		if (UGRBFOVAnimatorComponent* const FOVAnimator = IsValid(mOwningHero) ? mOwningHero->FindComponentByClass<UGRBFOVAnimatorComponent>() : nullptr)
+		{
+			FOVAnimator->OnFOVChangeFinished.Remove(m1PZoomResetFinishedHandle);
+		}
+		m1PZoomResetFinishedHandle.Reset();
+	}
+	if (const UWorld* const World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(m1PZoomResetTimerHandle);
+	}
+	m1PZoomResetChangeId = 0;
+}
+
 void UGA_GRBRocketLauncherSecondary::HandleTargetData(const FGameplayAbilityTargetDataHandle& InTargetDataHandle)
 {
 	/**
@@ -1018,7 +1058,23 @@ void UGA_GRBRocketLauncherSecondary::HandleTargetData_PerformAction(const int32
 				const FHitResult& TraceHit = UAbilitySystemBlueprintLibrary::GetHitResultFromTargetData(CachedTargetDataHandleWhenConfirmed, InActionNumber);
 				const FRotator& LookAtRotation = UKismetMathLibrary::FindLookAtRotation(TraceHit.TraceStart, TraceHit.Location);
 				// 生成追踪弹
-				if (mOwningHero->HasAuthority())
+				if (mOwningHero->HasAuthority() && mUseLightweightProjectile)
+				{
+					if (UGRBProjectileManagerSubsystem* const ProjectileManager = GetWorld()->GetSubsystem<UGRBProjectileManagerSubsystem>())
+					{
+						FGRBProjectileSpawnParams SpawnParams;
+						SpawnParams.Origin = TraceHit.TraceStart;
+						SpawnParams.Direction = LookAtRotation.Vector();
+						SpawnParams.HomingTarget = HittedGRBCharacterBase;
+						SpawnParams.HomingAccelerationMagnitude = mHomingAccelerationMagnitude;
+						SpawnParams.Instigator = mOwningHero;
+						SpawnParams.InstigatorASC = Cast<UGRBAbilitySystemComponent>(GetAbilitySystemComponentFromActorInfo());
+						SpawnParams.EffectContainerSpec = GRBGEContainerSpecPak;
+						SpawnParams.ImpactCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.RocketLauncher.Impact"));
+						ProjectileManager->SpawnProjectile(SpawnParams);
+					}
+				}
+				else if (mOwningHero->HasAuthority())
 				{
 					FSoftObjectPath SoftObjectPaths_Actor1 = FSoftObjectPath(TEXT("/Script/Engine.Blueprint'/Game/GRBShooter/Weapons/RocketLauncher/BP_RocketLauncherProjectile1.BP_RocketLauncherProjectile1_C'"));
 					UClass* GRBProjectileBP = UAssetManager::GetStreamableManager().LoadSynchronous<UClass>(SoftObjectPaths_Actor1);
@@ -1034,6 +1090,13 @@ void UGA_GRBRocketLauncherSecondary::HandleTargetData_PerformAction(const int32
 					SpawnedGRBProjectile->mIsHoming = true;
 					SpawnedGRBProjectile->mHomingTarget = HittedGRBCharacterBase;
 					SpawnedGRBProjectile->SetInstigator(mOwningHero);
+					SpawnedGRBProjectile->mGRBASC = Cast<UGRBAbilitySystemComponent>(GetAbilitySystemComponentFromActorInfo());
+					SpawnedGRBProjectile->mFireCueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, FGameplayEffectContextHandle(),
+					                                                                                                    FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
+					                                                                                                    FGameplayTagContainer(), SpawnLoc, SpawnRot.Vector(),
+					                                                                                                    mOwningHero, nullptr, nullptr,
+					                                                                                                    nullptr, 1, 1,
+					                                                                                                    nullptr, false);
 					SpawnedGRBProjectile->FinishSpawning(PSpawnTrans);
 				}
 
@@ -1106,42 +1169,16 @@ void UGA_GRBRocketLauncherSecondary::PlayFireMontage()
 	{
 		if (UAnimMontage* pMontageAsset = LoadObject<UAnimMontage>(mOwningHero, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/FPP_LauncherAimFire_Montage.FPP_LauncherAimFire_Montage'")))
 		{
-			UGRBAT_PlayMontageForMeshAndWaitForEvent* Node = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayMontageForMeshAndWaitForEvent(
-				this,
-				FName("None"),
-				mOwningHero->GetFirstPersonMesh(),
-				pMontageAsset,
-				FGameplayTagContainer(),
-				1,
-				FName("None"),
-				false,
-				1,
-				false,
-				-1,
-				-1
-			);
-			Node->ReadyForActivation();
+			// 连发时复用同一个任务重播, 不再每发新建任务与注册委托
+			mFireMontageTask = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(mFireMontageTask, this, mOwningHero->GetFirstPersonMesh(), pMontageAsset, 1, FName("None"), false, false);
 		}
 	}
 	else
 	{
 		if (UAnimMontage* pMontageAsset = LoadObject<UAnimMontage>(mOwningHero, TEXT("/Script/Engine.AnimMontage'/Game/ShooterGame/Animations/FPP_Animations/HeroFPP_LauncherFire_Montage.HeroFPP_LauncherFire_Montage'")))
 		{
-			UGRBAT_PlayMontageForMeshAndWaitForEvent* Node = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayMontageForMeshAndWaitForEvent(
-				this,
-				FName("None"),
-				mOwningHero->GetFirstPersonMesh(),
-				pMontageAsset,
-				FGameplayTagContainer(),
-				1,
-				FName("None"),
-				false,
-				1,
-				false,
-				-1,
-				-1
-			);
-			Node->ReadyForActivation();
+			// 连发时复用同一个任务重播, 不再每发新建任务与注册委托
+			mFireMontageTask = UGRBAT_PlayMontageForMeshAndWaitForEvent::PlayOrRestartMontageForMesh(mFireMontageTask, this, mOwningHero->GetFirstPersonMesh(), pMontageAsset, 1, FName("None"), false, false);
 		}
 	}
 }
@@ -1174,6 +1211,7 @@ void UGA_GRBRocketLauncherSecondary::CheckAndSetupCacheables()
 	if (!IsValid(mSphereTraceTargetActor))
 	{
 		mSphereTraceTargetActor = mSourceWeapon->GetSphereTraceTargetActor();
+		ConfigureSphereTraceTargetActor();
 	}
 	if (!IsValid(mGRBPlayerController))
 	{
@@ -1181,4 +1219,36 @@ void UGA_GRBRocketLauncherSecondary::CheckAndSetupCacheables()
 	}
 }
 
+///--@brief 装备后一次性配置球型探查器; 之后每回合索敌只更新起点与命中上限--/
+void UGA_GRBRocketLauncherSecondary::ConfigureSphereTraceTargetActor()
+{
+	if (!IsValid(mSphereTraceTargetActor) || !IsValid(mSourceWeapon))
+	{
+		return;
+	}
+
+	if (const FGRBWeaponFireParams* const FireParams = mSourceWeapon->GetFireParams())
+	{
+		mTraceParams = FireParams->SecondaryTrace;
+		mMaxRange = mTraceParams.MaxRange;
+		mMaxTargets = FMath::Max(mTraceParams.MaxHitResultsPerTrace, 1);
+	}
+	else
+	{
+		// 未配置武器定义: 持续命中的球型索敌, 命中上限每回合按残余弹量裁剪
+		mTraceParams = FGRBWeaponTraceParams();
+		mTraceParams.ReticleClass = UAssetManager::GetStreamableManager().LoadSynchronous<UClass>(FSoftObjectPath(TEXT("/Script/Engine.Blueprint'/Game/GRBShooter/Characters/Shared/Targeting/BP_SingleTargetReticle.BP_SingleTargetReticle_C'")));
+		mTraceParams.MaxRange = mMaxRange;
+		mTraceParams.TraceSphereRadius = 32.0f;
+		mTraceParams.MaxHitResultsPerTrace = mMaxTargets;
+		mTraceParams.bUsePersistentHitResults = true;
+		mTraceParams.bTraceFromPlayerViewPoint = true;
+	}
+
+	mbTraceConfiguredFirstPerson = !IsValid(mOwningHero) || mOwningHero->IsInFirstPersonPerspective();
+	mTraceStartLocation = mTraceParams.MakeMuzzleLocation(mbTraceConfiguredFirstPerson ? Weapon1PMesh : Weapon3PMesh);
+	mTraceFromPlayerViewPointg = mbTraceConfiguredFirstPerson;
+	mTraceConfigVersion = mTraceParams.ConfigureSphereTrace(mSphereTraceTargetActor, mTraceStartLocation);
+}
+
 #pragma endregion
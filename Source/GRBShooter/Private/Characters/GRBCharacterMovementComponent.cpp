@@ -1,9 +1,33 @@
 #include "Characters/GRBCharacterMovementComponent.h"
 #include "Characters/Abilities/GRBAbilitySystemGlobals.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GRBAbilitySystemComponent.h"
 #include "Characters/GRBCharacterBase.h"
+#include "Characters/Abilities/AttributeSets/GRBAttributeSetBase.h"
 #include "GameplayTagContainer.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
+CSV_DEFINE_CATEGORY(GRBMovement, true);
+
+static TAutoConsoleVariable<int32> CVarMovementLogCorrections(
+	TEXT("GRB.movement.LogCorrections"),
+	0,
+	TEXT("Log every server-side movement correction with its attributed cause and error distance")
+);
+
+DECLARE_STATS_GROUP(TEXT("GRBMovement"), STATGROUP_GRBMovement, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RefreshSpeedModifierState"), STAT_GRBMovement_RefreshSpeedModifierState, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpeedModifierRefreshes"), STAT_GRBMovement_SpeedModifierRefreshes, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ServerMovesChecked"), STAT_GRBMovement_ServerMovesChecked, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ServerCorrections"), STAT_GRBMovement_ServerCorrections, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corrections (SpeedModifier)"), STAT_GRBMovement_CorrectionsSpeedModifier, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corrections (MovementMode)"), STAT_GRBMovement_CorrectionsMovementMode, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corrections (SprintADS)"), STAT_GRBMovement_CorrectionsSprintADS, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corrections (Physics)"), STAT_GRBMovement_CorrectionsPhysics, STATGROUP_GRBMovement);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("CorrectionErrorDistance"), STAT_GRBMovement_CorrectionErrorDistance, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ClientMoves"), STAT_GRBMovement_ClientMoves, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CombinedMoves"), STAT_GRBMovement_CombinedMoves, STATGROUP_GRBMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SavedMoveDepth"), STAT_GRBMovement_SavedMoveDepth, STATGROUP_GRBMovement);
 
 UGRBCharacterMovementComponent::UGRBCharacterMovementComponent()
 {
@@ -12,48 +36,69 @@ UGRBCharacterMovementComponent::UGRBCharacterMovementComponent()
 	KnockedDownSpeedMultiplier = 0.4f;
 
 	KnockedDownTag = FGameplayTag::RequestGameplayTag("State.KnockedDown");
-	InteractingTag = FGameplayTag::RequestGameplayTag("State.Interacting");
-	InteractingRemovalTag = FGameplayTag::RequestGameplayTag("State.InteractingRemoval");
+
+	CachedMoveSpeed = 0.0f;
+	bCachedIsAlive = false;
+	bCachedIsKnockedDown = false;
+	bSpeedModifierDelegatesBound = false;
+	bHasSpeedModifierOverride = false;
+	SpeedModifierOverride = GRBSpeedModifierFull;
+	bLastServerMoveInputChanged = false;
+	bLastServerMoveSpeedModifierMismatch = false;
+
+	SetNetworkMoveDataContainer(GRBMoveDataContainer);
+}
+
+void UGRBCharacterMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindSpeedModifierDelegates();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UGRBCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateMoveCorrectionMetrics(DeltaTime);
 }
 
 /** 方法的主要作用是提供角色在当前状态下的最大可能移动速度。这个方法可能会根据多种状态和条件返回不同的速度值*/
+/** 移动Tick与服务端回放中会被高频调用; 这里只读取由ASC回调维护的缓存, 不做Cast与Tag查询 */
 float UGRBCharacterMovementComponent::GetMaxSpeed() const
 {
-	AGRBCharacterBase* Owner = Cast<AGRBCharacterBase>(GetOwner());
-	if (!Owner)
+	// 回调由ASC初始化角色信息时绑定(见 BindSpeedModifierDelegates); 绑定前(或宿主不是GRB角色)直接读取宿主实时状态
+	const AGRBCharacterBase* const Owner = bSpeedModifierDelegatesBound ? nullptr : Cast<AGRBCharacterBase>(GetOwner());
+	if (!bSpeedModifierDelegatesBound && !Owner)
 	{
 		UE_LOG(LogTemp, Error, TEXT("%s() No Owner"), *FString(__FUNCTION__));
 		return Super::GetMaxSpeed();
 	}
+	const float MoveSpeed = bSpeedModifierDelegatesBound ? CachedMoveSpeed : Owner->GetMoveSpeed();
 
-	// 玩家死亡不允许移动
-	if (!Owner->IsAlive())
+	// 服务端执行客户端移动/客户端回放时, 以随移动包一起传递的速度修正为准, 保证双端结果一致
+	const uint8 SpeedModifier = bHasSpeedModifierOverride ? SpeedModifierOverride : GetQuantizedSpeedModifier();
+	// 玩家死亡不允许移动; 被治疗或者在交互中，不允许移动
+	if (SpeedModifier == 0)
 	{
 		return 0.0f;
 	}
-
-	// 被治疗或者在交互中，不允许移动
-	if (Owner->GetAbilitySystemComponent() && Owner->GetAbilitySystemComponent()->GetTagCount(InteractingTag) > Owner->GetAbilitySystemComponent()->GetTagCount(InteractingRemovalTag))
+	// 玩家被击倒等技能修正, 此时不再叠加输入倍率
+	if (SpeedModifier != GRBSpeedModifierFull)
 	{
-		return 0.0f;
-	}
-	// 玩家被击倒
-	if (Owner->GetAbilitySystemComponent() && Owner->GetAbilitySystemComponent()->HasMatchingGameplayTag(KnockedDownTag))
-	{
-		return Owner->GetMoveSpeed() * KnockedDownSpeedMultiplier;
+		return MoveSpeed * DequantizeSpeedModifier(SpeedModifier);
 	}
 	// 玩家收到冲刺输入, 有倍率
 	if (RequestToStartSprinting)
 	{
-		return Owner->GetMoveSpeed() * SprintSpeedMultiplier;
+		return MoveSpeed * SprintSpeedMultiplier;
 	}
 	// 玩家收到ADS输入, 有倍率
 	if (RequestToStartADS)
 	{
-		return Owner->GetMoveSpeed() * ADSSpeedMultiplier;
+		return MoveSpeed * ADSSpeedMultiplier;
 	}
 
-	return Owner->GetMoveSpeed();
+	return MoveSpeed;
 }
 
 /** 主要功能是将压缩标志位解压，更新角色的相关状态。例如，标志位可以表示角色是否正在冲刺、是否正在跳跃、是否在蹲伏等; 会与移动队列的虚方法GetCompressedFlags关联*/
@@ -88,6 +133,139 @@ FNetworkPredictionData_Client* UGRBCharacterMovementComponent::GetPredictionData
 	return ClientPredictionData;
 }
 
+void UGRBCharacterMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	// 仅在处理客户端打包上来的移动时不为空
+	const FGRBCharacterNetworkMoveData* const MoveData = static_cast<const FGRBCharacterNetworkMoveData*>(GetCurrentNetworkMoveData());
+	if (MoveData)
+	{
+		// 取双端更严格的一方: 客户端先于服务端预测到减速(如交互定身)时不产生纠正, 同时客户端无法借此加速
+		const uint8 ServerSpeedModifier = GetQuantizedSpeedModifier();
+		bHasSpeedModifierOverride = true;
+		SpeedModifierOverride = FMath::Min(MoveData->SpeedModifier, ServerSpeedModifier);
+
+		// 记录本次移动的归因信息, 供随后的ServerCheckClientError使用
+		const uint8 InputFlags = CompressedFlags & (FSavedMove_Character::FLAG_Custom_0 | FSavedMove_Character::FLAG_Custom_1);
+		bLastServerMoveInputChanged = InputFlags != LastServerMoveInputFlags;
+		bLastServerMoveSpeedModifierMismatch = MoveData->SpeedModifier != ServerSpeedModifier;
+		LastServerMoveInputFlags = InputFlags;
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+
+	bHasSpeedModifierOverride = false;
+}
+
+bool UGRBCharacterMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+	// 回放期间由各SavedMove的PrepMoveFor写入, 回放结束后恢复为读取缓存
+	bHasSpeedModifierOverride = false;
+	return bResult;
+}
+
+bool UGRBCharacterMovementComponent::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	const bool bNeedsCorrection = Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+
+	++ServerCheckedMoveCount;
+	INC_DWORD_STAT(STAT_GRBMovement_ServerMovesChecked);
+	if (bNeedsCorrection)
+	{
+		++ServerCorrectionCount;
+		INC_DWORD_STAT(STAT_GRBMovement_ServerCorrections);
+		RecordServerCorrection(ClientWorldLocation, ClientMovementMode);
+	}
+	return bNeedsCorrection;
+}
+
+#pragma region ~ 移动纠正统计 ~
+void UGRBCharacterMovementComponent::RecordServerCorrection(const FVector& ClientWorldLocation, uint8 ClientMovementMode)
+{
+	const float ErrorDistance = UpdatedComponent ? FVector::Dist(ClientWorldLocation, UpdatedComponent->GetComponentLocation()) : 0.0f;
+
+	// 客户端上报的移动模式与服务端打包方式一致(低4位为MovementMode)
+	TEnumAsByte<EMovementMode> ClientMode;
+	TEnumAsByte<EMovementMode> ClientGroundMode;
+	uint8 ClientCustomMode;
+	UnpackNetworkMovementMode(ClientMovementMode, ClientMode, ClientCustomMode, ClientGroundMode);
+
+	EGRBMoveCorrectionCause Cause = EGRBMoveCorrectionCause::Physics;
+	if (bLastServerMoveSpeedModifierMismatch)
+	{
+		Cause = EGRBMoveCorrectionCause::SpeedModifier;
+	}
+	else if (ClientMode != MovementMode)
+	{
+		Cause = EGRBMoveCorrectionCause::MovementMode;
+	}
+	else if (bLastServerMoveInputChanged)
+	{
+		Cause = EGRBMoveCorrectionCause::SprintADS;
+	}
+
+	++WindowCorrections;
+	WindowErrorDistanceSum += ErrorDistance;
+	++WindowCorrectionsByCause[static_cast<uint8>(Cause)];
+
+	INC_FLOAT_STAT_BY(STAT_GRBMovement_CorrectionErrorDistance, ErrorDistance);
+	switch (Cause)
+	{
+	case EGRBMoveCorrectionCause::SpeedModifier: INC_DWORD_STAT(STAT_GRBMovement_CorrectionsSpeedModifier); break;
+	case EGRBMoveCorrectionCause::MovementMode: INC_DWORD_STAT(STAT_GRBMovement_CorrectionsMovementMode); break;
+	case EGRBMoveCorrectionCause::SprintADS: INC_DWORD_STAT(STAT_GRBMovement_CorrectionsSprintADS); break;
+	default: INC_DWORD_STAT(STAT_GRBMovement_CorrectionsPhysics); break;
+	}
+
+	if (CVarMovementLogCorrections.GetValueOnGameThread() != 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s() %s corrected: Cause=%s Error=%.1fcm"), *FString(__FUNCTION__), *GetNameSafe(GetOwner()), *UEnum::GetValueAsString(Cause), ErrorDistance);
+	}
+}
+
+void UGRBCharacterMovementComponent::UpdateMoveCorrectionMetrics(float DeltaTime)
+{
+	// 主控客户端的SavedMove缓冲深度
+	const bool bTracksSavedMoves = ClientPredictionData && CharacterOwner && CharacterOwner->IsLocallyControlled();
+	const int32 SavedMoveDepth = bTracksSavedMoves ? ClientPredictionData->SavedMoves.Num() : 0;
+	INC_DWORD_STAT_BY(STAT_GRBMovement_SavedMoveDepth, SavedMoveDepth);
+
+	CorrectionWindowTime += DeltaTime;
+	if (CorrectionWindowTime >= 1.0f)
+	{
+		MoveCorrectionMetrics.CorrectionsPerSecond = WindowCorrections / CorrectionWindowTime;
+		MoveCorrectionMetrics.AverageErrorDistance = WindowCorrections > 0 ? WindowErrorDistanceSum / WindowCorrections : 0.0f;
+		MoveCorrectionMetrics.SavedMoveDepth = SavedMoveDepth;
+		MoveCorrectionMetrics.CombinedMoveRatio = WindowClientMoves > 0 ? static_cast<float>(WindowCombinedMoves) / WindowClientMoves : 0.0f;
+		FMemory::Memcpy(MoveCorrectionMetrics.CorrectionsByCause, WindowCorrectionsByCause, sizeof(WindowCorrectionsByCause));
+
+		CorrectionWindowTime = 0.0f;
+		WindowCorrections = 0;
+		WindowErrorDistanceSum = 0.0f;
+		WindowClientMoves = 0;
+		WindowCombinedMoves = 0;
+		FMemory::Memzero(WindowCorrectionsByCause, sizeof(WindowCorrectionsByCause));
+	}
+
+	// 每帧以Set写入最近一个窗口的结算值, CSV曲线为每秒一阶的阶梯而不是每秒一帧的尖峰
+	// 纠正指标只由校验过客户端移动的服务端组件写入, 缓冲指标只由主控客户端写入; 单连接明细见 GRB.movement.LogCorrections 与 GetMoveCorrectionMetrics
+	if (ServerCheckedMoveCount > 0)
+	{
+		CSV_CUSTOM_STAT(GRBMovement, CorrectionsPerSecond, MoveCorrectionMetrics.CorrectionsPerSecond, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GRBMovement, AverageErrorDistance, MoveCorrectionMetrics.AverageErrorDistance, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GRBMovement, CorrectionsSpeedModifier, MoveCorrectionMetrics.CorrectionsByCause[static_cast<uint8>(EGRBMoveCorrectionCause::SpeedModifier)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GRBMovement, CorrectionsMovementMode, MoveCorrectionMetrics.CorrectionsByCause[static_cast<uint8>(EGRBMoveCorrectionCause::MovementMode)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GRBMovement, CorrectionsSprintADS, MoveCorrectionMetrics.CorrectionsByCause[static_cast<uint8>(EGRBMoveCorrectionCause::SprintADS)], ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GRBMovement, CorrectionsPhysics, MoveCorrectionMetrics.CorrectionsByCause[static_cast<uint8>(EGRBMoveCorrectionCause::Physics)], ECsvCustomStatOp::Set);
+	}
+	if (bTracksSavedMoves)
+	{
+		CSV_CUSTOM_STAT(GRBMovement, SavedMoveDepth, SavedMoveDepth, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(GRBMovement, CombinedMoveRatio, MoveCorrectionMetrics.CombinedMoveRatio, ECsvCustomStatOp::Set);
+	}
+}
+#pragma endregion
+
 void UGRBCharacterMovementComponent::StartSprinting()
 {
 	RequestToStartSprinting = true;
@@ -108,12 +286,131 @@ void UGRBCharacterMovementComponent::StopAimDownSights()
 	RequestToStartADS = false;
 }
 
+#pragma region ~ 速度修正缓存 ~
+void UGRBCharacterMovementComponent::BindSpeedModifierDelegates(UGRBAbilitySystemComponent* InASC)
+{
+	if (!InASC)
+	{
+		return;
+	}
+	if (SpeedModifierASC.Get() != InASC)
+	{
+		UnbindSpeedModifierDelegates();
+
+		// 交互状态由ASC按Tag层数变化维护, 这里不再单独订阅
+		SpeedModifierASC = InASC;
+		KnockedDownTagChangedHandle = InASC->RegisterGameplayTagEvent(KnockedDownTag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &UGRBCharacterMovementComponent::OnKnockedDownTagChanged);
+		MoveSpeedChangedHandle = InASC->GetGameplayAttributeValueChangeDelegate(UGRBAttributeSetBase::GetMoveSpeedAttribute()).AddUObject(this, &UGRBCharacterMovementComponent::OnMoveSpeedChanged);
+		HealthChangedHandle = InASC->GetGameplayAttributeValueChangeDelegate(UGRBAttributeSetBase::GetHealthAttribute()).AddUObject(this, &UGRBCharacterMovementComponent::OnHealthChanged);
+		bSpeedModifierDelegatesBound = true;
+	}
+
+	// 绑定时(以及ASC重新初始化, 如重生后)全量刷新一次, 存活/击倒/移速缓存从这里开始有效
+	RefreshSpeedModifierState();
+}
+
+void UGRBCharacterMovementComponent::UnbindSpeedModifierDelegates()
+{
+	if (UGRBAbilitySystemComponent* const ASC = SpeedModifierASC.Get())
+	{
+		ASC->RegisterGameplayTagEvent(KnockedDownTag, EGameplayTagEventType::NewOrRemoved).Remove(KnockedDownTagChangedHandle);
+		ASC->GetGameplayAttributeValueChangeDelegate(UGRBAttributeSetBase::GetMoveSpeedAttribute()).Remove(MoveSpeedChangedHandle);
+		ASC->GetGameplayAttributeValueChangeDelegate(UGRBAttributeSetBase::GetHealthAttribute()).Remove(HealthChangedHandle);
+	}
+
+	SpeedModifierASC.Reset();
+	KnockedDownTagChangedHandle.Reset();
+	MoveSpeedChangedHandle.Reset();
+	HealthChangedHandle.Reset();
+	bSpeedModifierDelegatesBound = false;
+}
+
+void UGRBCharacterMovementComponent::RefreshSpeedModifierState()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBMovement_RefreshSpeedModifierState);
+	INC_DWORD_STAT(STAT_GRBMovement_SpeedModifierRefreshes);
+
+	const AGRBCharacterBase* const Owner = Cast<AGRBCharacterBase>(GetOwner());
+	if (!Owner)
+	{
+		return;
+	}
+
+	const UAbilitySystemComponent* const ASC = Owner->GetAbilitySystemComponent();
+	CachedMoveSpeed = Owner->GetMoveSpeed();
+	bCachedIsAlive = Owner->IsAlive();
+	bCachedIsKnockedDown = ASC && ASC->HasMatchingGameplayTag(KnockedDownTag);
+}
+
+uint8 UGRBCharacterMovementComponent::GetQuantizedSpeedModifier() const
+{
+	if (bSpeedModifierDelegatesBound)
+	{
+		const UGRBAbilitySystemComponent* const ASC = SpeedModifierASC.Get();
+		return MakeQuantizedSpeedModifier(bCachedIsAlive, bCachedIsKnockedDown, ASC && ASC->IsInteracting());
+	}
+
+	// 尚未绑定时实时读取
+	const AGRBCharacterBase* const Owner = Cast<AGRBCharacterBase>(GetOwner());
+	if (!Owner)
+	{
+		return GRBSpeedModifierFull;
+	}
+	const UAbilitySystemComponent* const ASC = Owner->GetAbilitySystemComponent();
+	const UGRBAbilitySystemComponent* const GRBASC = Cast<UGRBAbilitySystemComponent>(ASC);
+	return MakeQuantizedSpeedModifier(Owner->IsAlive(), ASC && ASC->HasMatchingGameplayTag(KnockedDownTag), GRBASC && GRBASC->IsInteracting());
+}
+
+uint8 UGRBCharacterMovementComponent::MakeQuantizedSpeedModifier(bool bInIsAlive, bool bInIsKnockedDown, bool bInIsInteracting) const
+{
+	if (!bInIsAlive || bInIsInteracting)
+	{
+		return 0;
+	}
+	if (bInIsKnockedDown)
+	{
+		return QuantizeSpeedModifier(KnockedDownSpeedMultiplier);
+	}
+	return GRBSpeedModifierFull;
+}
+
+uint8 UGRBCharacterMovementComponent::QuantizeSpeedModifier(float InMultiplier)
+{
+	return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(InMultiplier * GRBSpeedModifierFull), 0, MAX_uint8));
+}
+
+float UGRBCharacterMovementComponent::DequantizeSpeedModifier(uint8 InSpeedModifier)
+{
+	return static_cast<float>(InSpeedModifier) / GRBSpeedModifierFull;
+}
+
+void UGRBCharacterMovementComponent::OnKnockedDownTagChanged(const FGameplayTag InTag, int32 InNewCount)
+{
+	bCachedIsKnockedDown = InNewCount > 0;
+}
+
+void UGRBCharacterMovementComponent::OnMoveSpeedChanged(const FOnAttributeChangeData& InData)
+{
+	CachedMoveSpeed = InData.NewValue;
+}
+
+void UGRBCharacterMovementComponent::OnHealthChanged(const FOnAttributeChangeData& InData)
+{
+	// 存活判定交给宿主的虚函数IsAlive, 这里只在生命值变化时重新取一次
+	if (const AGRBCharacterBase* const Owner = Cast<AGRBCharacterBase>(GetOwner()))
+	{
+		bCachedIsAlive = Owner->IsAlive();
+	}
+}
+#pragma endregion
+
 void UGRBCharacterMovementComponent::FGRBSavedMove::Clear()
 {
 	Super::Clear();
 
 	SavedRequestToStartSprinting = false;
 	SavedRequestToStartADS = false;
+	SavedSpeedModifier = GRBSpeedModifierFull;
 }
 
 uint8 UGRBCharacterMovementComponent::FGRBSavedMove::GetCompressedFlags() const
@@ -146,6 +443,11 @@ bool UGRBCharacterMovementComponent::FGRBSavedMove::CanCombineWith(const FSavedM
 		return false;
 	}
 
+	if (SavedSpeedModifier != ((FGRBSavedMove*)NewMove.Get())->SavedSpeedModifier)
+	{
+		return false;
+	}
+
 	return Super::CanCombineWith(NewMove, Character, MaxDelta);
 }
 
@@ -161,6 +463,10 @@ void UGRBCharacterMovementComponent::FGRBSavedMove::SetMoveFor(ACharacter* Chara
 	{
 		SavedRequestToStartSprinting = CharacterMovement->RequestToStartSprinting;
 		SavedRequestToStartADS = CharacterMovement->RequestToStartADS;
+		SavedSpeedModifier = CharacterMovement->GetQuantizedSpeedModifier();
+
+		++CharacterMovement->WindowClientMoves;
+		INC_DWORD_STAT(STAT_GRBMovement_ClientMoves);
 	}
 }
 
@@ -174,9 +480,46 @@ void UGRBCharacterMovementComponent::FGRBSavedMove::PrepMoveFor(ACharacter* Char
 	UGRBCharacterMovementComponent* CharacterMovement = Cast<UGRBCharacterMovementComponent>(Character->GetCharacterMovement());
 	if (CharacterMovement)
 	{
+		// 回放时使用当初这次移动生效的速度修正, 而非当前缓存
+		CharacterMovement->bHasSpeedModifierOverride = true;
+		CharacterMovement->SpeedModifierOverride = SavedSpeedModifier;
 	}
 }
 
+void UGRBCharacterMovementComponent::FGRBSavedMove::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	UGRBCharacterMovementComponent* CharacterMovement = Cast<UGRBCharacterMovementComponent>(InCharacter->GetCharacterMovement());
+	if (CharacterMovement)
+	{
+		++CharacterMovement->WindowCombinedMoves;
+		INC_DWORD_STAT(STAT_GRBMovement_CombinedMoves);
+	}
+}
+
+void UGRBCharacterMovementComponent::FGRBCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	SpeedModifier = static_cast<const FGRBSavedMove&>(ClientMove).GetSavedSpeedModifier();
+}
+
+bool UGRBCharacterMovementComponent::FGRBCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	Ar << SpeedModifier;
+	return !Ar.IsError();
+}
+
+UGRBCharacterMovementComponent::FGRBCharacterNetworkMoveDataContainer::FGRBCharacterNetworkMoveDataContainer()
+{
+	NewMoveData = &GRBDefaultMoveData[0];
+	PendingMoveData = &GRBDefaultMoveData[1];
+	OldMoveData = &GRBDefaultMoveData[2];
+}
+
 UGRBCharacterMovementComponent::FGRBNetworkPredictionData_Client::FGRBNetworkPredictionData_Client(const UCharacterMovementComponent& ClientMovement)
 	: Super(ClientMovement)
 {
@@ -0,0 +1,142 @@
+// Copyright 2024 GRB.
+
+
+#include "Characters/GRBFOVAnimatorComponent.h"
+#include "Camera/CameraComponent.h"
+#include "Curves/CurveFloat.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Player/GRBPlayerCameraManager.h"
+
+UGRBFOVAnimatorComponent::UGRBFOVAnimatorComponent()
+{
+	// 由相机管理器推进, 自身不需要Tick
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(false);
+}
+
+UGRBFOVAnimatorComponent* UGRBFOVAnimatorComponent::FindOrAddFOVAnimator(AActor* InOwner)
+{
+	if (!IsValid(InOwner))
+	{
+		return nullptr;
+	}
+
+	UGRBFOVAnimatorComponent* Animator = InOwner->FindComponentByClass<UGRBFOVAnimatorComponent>();
+	if (!Animator)
+	{
+		Animator = NewObject<UGRBFOVAnimatorComponent>(InOwner, TEXT("GRBFOVAnimator"));
+		Animator->RegisterComponent();
+	}
+	return Animator;
+}
+
+uint32 UGRBFOVAnimatorComponent::StartFOVChange(UCameraComponent* InCamera, float InTargetFOV, float InDuration, UCurveFloat* InOptionalInterpolationCurve)
+{
+	// 先占用本段ID再打断旧插值: 打断广播里的回调可能立刻开始新的插值, 不能让它拿走调用方经GetNextFOVChangeId预先读取的ID
+	const uint32 ChangeId = NextChangeId++;
+	if (NextChangeId == 0)
+	{
+		NextChangeId = 1;
+	}
+
+	// 同一时刻只保留一段插值, 新的打断旧的; 回调里新开始的插值同样被本段打断
+	while (IsChangingFOV())
+	{
+		FinishFOVChange(false);
+	}
+
+	if (!InCamera)
+	{
+		return ChangeId;
+	}
+
+	Camera = InCamera;
+	LerpCurve = InOptionalInterpolationCurve;
+	StartFOV = InCamera->FieldOfView;
+	TargetFOV = InTargetFOV;
+	Duration = FMath::Max(InDuration, 0.001f); // Avoid negative or divide-by-zero cases
+	ElapsedTime = 0.0f;
+	ActiveChangeId = ChangeId;
+
+	AGRBPlayerCameraManager* const CameraManager = FindCameraManager();
+	if (CameraManager)
+	{
+		CameraManager->RegisterFOVAnimator(this);
+	}
+	else
+	{
+		// 没有本地相机会去渲染这个FOV, 直接到位
+		InCamera->SetFieldOfView(TargetFOV);
+		FinishFOVChange(true);
+	}
+	return ChangeId;
+}
+
+void UGRBFOVAnimatorComponent::StopFOVChange()
+{
+	if (IsChangingFOV())
+	{
+		FinishFOVChange(false);
+	}
+}
+
+bool UGRBFOVAnimatorComponent::AdvanceFOVChange(float DeltaTime)
+{
+	if (!IsChangingFOV())
+	{
+		return false;
+	}
+
+	UCameraComponent* const CameraComponent = Camera.Get();
+	if (!CameraComponent)
+	{
+		FinishFOVChange(false);
+		// 结束回调里可能已开始下一段插值; 本组件仍在管理器列表中, 须继续被推进
+		return IsChangingFOV();
+	}
+
+	ElapsedTime += DeltaTime;
+	if (ElapsedTime >= Duration)
+	{
+		CameraComponent->SetFieldOfView(TargetFOV);
+		FinishFOVChange(true);
+		return IsChangingFOV();
+	}
+
+	float MoveFraction = ElapsedTime / Duration;
+	if (LerpCurve)
+	{
+		MoveFraction = LerpCurve->GetFloatValue(MoveFraction);
+	}
+	CameraComponent->SetFieldOfView(FMath::Lerp<float, float>(StartFOV, TargetFOV, MoveFraction));
+	return true;
+}
+
+void UGRBFOVAnimatorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopFOVChange();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UGRBFOVAnimatorComponent::FinishFOVChange(bool bReachedTarget)
+{
+	const uint32 FinishedChangeId = ActiveChangeId;
+	ActiveChangeId = 0;
+	LerpCurve = nullptr;
+	Camera.Reset();
+
+	// 广播放在最后, 回调里可能立刻开始下一段插值
+	OnFOVChangeFinished.Broadcast(FinishedChangeId, bReachedTarget);
+}
+
+AGRBPlayerCameraManager* UGRBFOVAnimatorComponent::FindCameraManager() const
+{
+	const APawn* const OwnerPawn = Cast<APawn>(GetOwner());
+	const APlayerController* const PC = OwnerPawn ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	if (!PC || !PC->IsLocalController())
+	{
+		return nullptr;
+	}
+	return Cast<AGRBPlayerCameraManager>(PC->PlayerCameraManager);
+}
@@ -0,0 +1,169 @@
+// Copyright 2024 GRB.
+
+
+#include "Characters/GRBInventoryComponent.h"
+#include "Characters/Heroes/GRBHeroCharacter.h"
+#include "Net/UnrealNetwork.h"
+#include "Weapons/GRBWeapon.h"
+
+UGRBInventoryComponent::UGRBInventoryComponent()
+{
+	// 状态只在入包/装备时翻转, 不需要Tick
+	PrimaryComponentTick.bCanEverTick = false;
+	bWantsInitializeComponent = true;
+	SetIsReplicatedByDefault(true);
+}
+
+void UGRBInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(UGRBInventoryComponent, Slots);
+	DOREPLIFETIME(UGRBInventoryComponent, CurrentSlotIndex);
+}
+
+UGRBInventoryComponent* UGRBInventoryComponent::FindInventory(const AActor* InOwner)
+{
+	return IsValid(InOwner) ? InOwner->FindComponentByClass<UGRBInventoryComponent>() : nullptr;
+}
+
+void UGRBInventoryComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+	// 槽位数组一次定长, 之后只改槽内指针
+	Slots.SetNumZeroed(FMath::Max(NumSlots, 1));
+}
+
+int32 UGRBInventoryComponent::AddWeapon(AGRBWeapon* InWeapon)
+{
+	if (!GetOwner() || !GetOwner()->HasAuthority() || !IsValid(InWeapon) || FindSlotOfWeapon(InWeapon) != INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 FreeSlot = Slots.Find(nullptr);
+	if (FreeSlot == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// 入包时一次性挂接; 此时还不是当前武器, 挂接后即被收起
+	Slots[FreeSlot] = InWeapon;
+	InWeapon->SetOwningCharacter(GetOwningHero());
+
+	// 空手时直接装备
+	if (CurrentSlotIndex == INDEX_NONE)
+	{
+		EquipSlot(FreeSlot);
+	}
+	return FreeSlot;
+}
+
+bool UGRBInventoryComponent::RemoveWeapon(AGRBWeapon* InWeapon)
+{
+	if (!GetOwner() || !GetOwner()->HasAuthority())
+	{
+		return false;
+	}
+
+	const int32 SlotIndex = FindSlotOfWeapon(InWeapon);
+	if (SlotIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (SlotIndex == CurrentSlotIndex)
+	{
+		const int32 OldSlotIndex = CurrentSlotIndex;
+		CurrentSlotIndex = INDEX_NONE;
+		SwitchEquippedSlot(OldSlotIndex, INDEX_NONE);
+	}
+	Slots[SlotIndex] = nullptr;
+	InWeapon->SetOwningCharacter(nullptr);
+	return true;
+}
+
+bool UGRBInventoryComponent::EquipSlot(int32 InSlotIndex)
+{
+	if (!GetOwner() || !GetOwner()->HasAuthority() || !GetWeaponInSlot(InSlotIndex) || InSlotIndex == CurrentSlotIndex)
+	{
+		return false;
+	}
+
+	const int32 OldSlotIndex = CurrentSlotIndex;
+	CurrentSlotIndex = InSlotIndex;
+	SwitchEquippedSlot(OldSlotIndex, InSlotIndex);
+	return true;
+}
+
+void UGRBInventoryComponent::RefreshEquippedMeshState()
+{
+	ApplyEquippedState(GetCurrentWeapon());
+}
+
+int32 UGRBInventoryComponent::FindSlotOfWeapon(const AGRBWeapon* InWeapon) const
+{
+	return InWeapon ? Slots.IndexOfByKey(InWeapon) : INDEX_NONE;
+}
+
+void UGRBInventoryComponent::OnRep_Slots(const TArray<AGRBWeapon*>& OldSlots)
+{
+	// 移出背包的武器: 服务端的 SetOwningCharacter(nullptr) 不会在客户端执行, 这里复位为拾取展示;
+	// 已被其他英雄拾走(对方背包先同步到)的不动
+	for (AGRBWeapon* const OldWeapon : OldSlots)
+	{
+		if (IsValid(OldWeapon) && !Slots.Contains(OldWeapon) && (!OldWeapon->GetOwner() || OldWeapon->GetOwner() == GetOwner()))
+		{
+			OldWeapon->SetMeshState(EGRBWeaponMeshState::Pickup);
+		}
+	}
+
+	// 槽位变化(入包/移除/武器Actor晚于数组到达)才会走到这里, 槽位数固定且很小, 整体校正一遍
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		if (AGRBWeapon* const Weapon = Slots[SlotIndex])
+		{
+			if (SlotIndex == CurrentSlotIndex)
+			{
+				ApplyEquippedState(Weapon);
+			}
+			else
+			{
+				Weapon->SetMeshState(EGRBWeaponMeshState::Holstered);
+			}
+		}
+	}
+}
+
+void UGRBInventoryComponent::OnRep_CurrentSlotIndex(int32 OldSlotIndex)
+{
+	SwitchEquippedSlot(OldSlotIndex, CurrentSlotIndex);
+}
+
+void UGRBInventoryComponent::SwitchEquippedSlot(int32 InOldSlotIndex, int32 InNewSlotIndex)
+{
+	AGRBWeapon* const OldWeapon = GetWeaponInSlot(InOldSlotIndex);
+	AGRBWeapon* const NewWeapon = GetWeaponInSlot(InNewSlotIndex);
+	if (OldWeapon && OldWeapon != NewWeapon)
+	{
+		OldWeapon->SetMeshState(EGRBWeaponMeshState::Holstered);
+	}
+	ApplyEquippedState(NewWeapon);
+	OnEquippedWeaponChanged.Broadcast(OldWeapon, NewWeapon);
+}
+
+void UGRBInventoryComponent::ApplyEquippedState(AGRBWeapon* InWeapon) const
+{
+	if (!IsValid(InWeapon))
+	{
+		return;
+	}
+
+	const AGRBHeroCharacter* const Hero = GetOwningHero();
+	const bool bFirstPerson = Hero && Hero->IsInFirstPersonPerspective();
+	InWeapon->SetMeshState(bFirstPerson ? EGRBWeaponMeshState::Equipped1P : EGRBWeaponMeshState::Equipped3P);
+}
+
+AGRBHeroCharacter* UGRBInventoryComponent::GetOwningHero() const
+{
+	return Cast<AGRBHeroCharacter>(GetOwner());
+}
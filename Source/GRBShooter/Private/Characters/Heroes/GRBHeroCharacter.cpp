@@ -1,9 +1,40 @@
 #include "Characters/Heroes/GRBHeroCharacter.h"
+#include "Characters/GRBInventoryComponent.h"
 #include "Weapons/GRBWeapon.h"
+#include "Weapons/GRBWeaponPickupSubsystem.h"
+
+AGRBHeroCharacter::AGRBHeroCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	InventoryComponent = CreateDefaultSubobject<UGRBInventoryComponent>(TEXT("InventoryComponent"));
+}
+
+void AGRBHeroCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 拾取只在服务端判定
+	if (HasAuthority())
+	{
+		if (UGRBWeaponPickupSubsystem* const PickupSubsystem = GetWorld()->GetSubsystem<UGRBWeaponPickupSubsystem>())
+		{
+			PickupSubsystem->RegisterPawn(this);
+		}
+	}
+}
+
+void AGRBHeroCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGRBWeaponPickupSubsystem* const PickupSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UGRBWeaponPickupSubsystem>() : nullptr)
+	{
+		PickupSubsystem->UnregisterPawn(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
 
 AGRBWeapon* AGRBHeroCharacter::GetCurrentWeapon() const
 {
-	return nullptr;
+	return InventoryComponent ? InventoryComponent->GetCurrentWeapon() : nullptr;
 }
 
 bool AGRBHeroCharacter::IsInFirstPersonPerspective() const
@@ -0,0 +1,51 @@
+// Copyright 2024 GRB.
+
+
+#include "GRBNetUpdatePolicy.h"
+#include "GameFramework/Actor.h"
+
+///--@brief 把同步频率上下限与裁剪距离写回Actor; 仅服务端生效--/
+void FGRBNetUpdatePolicy::ApplyTo(AActor* InActor) const
+{
+	if (!InActor || !InActor->HasAuthority())
+	{
+		return;
+	}
+
+	InActor->NetUpdateFrequency = MaxNetUpdateFrequency;
+	InActor->MinNetUpdateFrequency = FMath::Min(MinNetUpdateFrequency, MaxNetUpdateFrequency);
+	if (NetCullDistance > 0.0f)
+	{
+		InActor->NetCullDistanceSquared = FMath::Square(NetCullDistance);
+	}
+}
+
+///--@brief 在Actor自身GetNetPriority的基础上按距离/视野朝向做缩放--/
+float FGRBNetUpdatePolicy::ScaleNetPriority(float InPriority, const AActor* InActor, const FVector& InViewPos, const FVector& InViewDir, const AActor* InViewer, const AActor* InViewTarget) const
+{
+	if (!InActor || IsViewerOwner(InActor, InViewer, InViewTarget))
+	{
+		return InPriority;
+	}
+
+	const FVector ToActor = InActor->GetActorLocation() - InViewPos;
+	const float Distance = ToActor.Size();
+
+	// 近处不衰减, 远处线性衰减到 FarPriorityScale
+	const float DistanceAlpha = FarDistance > NearDistance ? FMath::Clamp((Distance - NearDistance) / (FarDistance - NearDistance), 0.0f, 1.0f) : 0.0f;
+	float Scale = FMath::Lerp(1.0f, FarPriorityScale, DistanceAlpha);
+
+	// 位于视野背后
+	if (Distance > NearDistance && FVector::DotProduct(ToActor, InViewDir) < 0.0f)
+	{
+		Scale *= BehindViewPriorityScale;
+	}
+
+	return InPriority * Scale;
+}
+
+///--@brief 观察者是否为本Actor的主控连接--/
+bool FGRBNetUpdatePolicy::IsViewerOwner(const AActor* InActor, const AActor* InViewer, const AActor* InViewTarget)
+{
+	return InActor == InViewTarget || (InViewer && InActor->IsOwnedBy(InViewer)) || (InViewTarget && InActor->IsOwnedBy(InViewTarget));
+}
@@ -0,0 +1,82 @@
+// Copyright 2024 GRB.
+
+
+#include "Player/GRBDamageNumberBatch.h"
+#include "Characters/GRBCharacterBase.h"
+#include "UObject/CoreNet.h"
+
+namespace GRBDamageNumberBatch
+{
+	// 量化后单条伤害/命中次数的上限
+	constexpr int32 MaxQuantizedValue = MAX_uint16;
+
+	///--@brief 伤害量化为整数; 有伤害时至少为1, 避免小额伤害显示为0--/
+	static uint32 QuantizeDamage(float InDamage)
+	{
+		if (InDamage <= 0.0f)
+		{
+			return 0;
+		}
+		return static_cast<uint32>(FMath::Clamp(FMath::RoundToInt(InDamage), 1, MaxQuantizedValue));
+	}
+}
+
+///--@brief 量化并打包序列化--/
+bool FGRBDamageNumberBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	uint32 NumEntries = Ar.IsSaving() ? static_cast<uint32>(FMath::Min(Entries.Num(), MaxEntries)) : 0;
+	Ar.SerializeIntPacked(NumEntries);
+	if (Ar.IsLoading())
+	{
+		if (NumEntries > static_cast<uint32>(MaxEntries))
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return true;
+		}
+		Entries.SetNum(NumEntries);
+	}
+
+	uint32 HeadShotMask = 0;
+	for (uint32 Index = 0; Index < NumEntries; ++Index)
+	{
+		FGRBDamageNumberEntry& Entry = Entries[Index];
+
+		UObject* Target = Entry.TargetCharacter;
+		bOutSuccess &= Map ? Map->SerializeObject(Ar, AGRBCharacterBase::StaticClass(), Target) : false;
+
+		uint32 QuantizedDamage = Ar.IsSaving() ? GRBDamageNumberBatch::QuantizeDamage(Entry.DamageAmount) : 0;
+		uint32 HitCount = Ar.IsSaving() ? static_cast<uint32>(FMath::Clamp(Entry.HitCount, 1, GRBDamageNumberBatch::MaxQuantizedValue)) : 0;
+		Ar.SerializeIntPacked(QuantizedDamage);
+		Ar.SerializeIntPacked(HitCount);
+
+		if (Ar.IsSaving())
+		{
+			HeadShotMask |= Entry.bHeadShot ? (1u << Index) : 0u;
+		}
+		else
+		{
+			Entry.TargetCharacter = Cast<AGRBCharacterBase>(Target);
+			Entry.DamageAmount = static_cast<float>(FMath::Min<uint32>(QuantizedDamage, GRBDamageNumberBatch::MaxQuantizedValue));
+			Entry.HitCount = static_cast<int32>(FMath::Min<uint32>(HitCount, GRBDamageNumberBatch::MaxQuantizedValue));
+		}
+	}
+
+	// 爆头位掩码只占条目数个位
+	if (NumEntries > 0)
+	{
+		Ar.SerializeBits(&HeadShotMask, NumEntries);
+		if (Ar.IsLoading())
+		{
+			for (uint32 Index = 0; Index < NumEntries; ++Index)
+			{
+				Entries[Index].bHeadShot = (HeadShotMask & (1u << Index)) != 0;
+			}
+		}
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,28 @@
+// Copyright 2024 GRB.
+
+
+#include "Player/GRBPlayerCameraManager.h"
+#include "Characters/GRBFOVAnimatorComponent.h"
+
+void AGRBPlayerCameraManager::UpdateCamera(float DeltaTime)
+{
+	// 先推进FOV, 本帧取景(CalcCamera)即可读到新值
+	for (int32 Index = ActiveFOVAnimators.Num() - 1; Index >= 0; --Index)
+	{
+		UGRBFOVAnimatorComponent* const Animator = ActiveFOVAnimators[Index].Get();
+		if (!Animator || !Animator->AdvanceFOVChange(DeltaTime))
+		{
+			ActiveFOVAnimators.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	Super::UpdateCamera(DeltaTime);
+}
+
+void AGRBPlayerCameraManager::RegisterFOVAnimator(UGRBFOVAnimatorComponent* InAnimator)
+{
+	if (InAnimator)
+	{
+		ActiveFOVAnimators.AddUnique(InAnimator);
+	}
+}
@@ -6,13 +6,41 @@
 #include "Characters/Abilities/AttributeSets/GRBAttributeSetBase.h"
 #include "Characters/Abilities/GRBAbilitySystemComponent.h"
 #include "Characters/Heroes/GRBHeroCharacter.h"
+#include "Player/GRBPlayerCameraManager.h"
 #include "Player/GRBPlayerState.h"
 #include "UI/GRBHUDWidget.h"
+#include "TimerManager.h"
 #include "Weapons/GRBWeapon.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Number Hits"), STAT_GRBDamageNumberHits, STATGROUP_GRBAbility);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Number RPCs"), STAT_GRBDamageNumberRPCs, STATGROUP_GRBAbility);
+
+static TAutoConsoleVariable<float> CVarDamageNumberAggregateWindow(
+	TEXT("GRB.damageNumber.AggregateWindow"),
+	0.1f,
+	TEXT("Seconds over which hits on the same target are merged into one damage number before being sent to the attacker. <= 0 sends once per frame.")
+);
+
+AGRBPlayerController::AGRBPlayerController()
+{
+	// 定制相机管理器: 统一推进FOV动画器
+	PlayerCameraManagerClass = AGRBPlayerCameraManager::StaticClass();
+	UIHUDWidget = nullptr;
+}
+
 UGRBHUDWidget* AGRBPlayerController::GetGRBHUD()
 {
-	return nullptr;
+	return UIHUDWidget;
+}
+
+void AGRBPlayerController::SetGRBHUD(UGRBHUDWidget* InHUDWidget)
+{
+	if (UIHUDWidget == InHUDWidget)
+	{
+		return;
+	}
+	UIHUDWidget = InHUDWidget;
+	OnGRBHUDChanged.Broadcast();
 }
 
 void AGRBPlayerController::SetHUDReticle(TSubclassOf<UGRBHUDReticle> ReticleClass)
@@ -25,12 +53,82 @@ void AGRBPlayerController::SetEquippedWeaponStatusText(const FText& StatusText)
 	
 }
 
-void AGRBPlayerController::ShowDamageNumber_Implementation(float DamageAmount, AGRBCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags)
+#pragma region ~ 伤害数字聚合 ~
+///--@brief 服务端: 记下一次命中, 按目标并入当前聚合窗口; 窗口结束时整批下发--/
+void AGRBPlayerController::QueueDamageNumber(float DamageAmount, AGRBCharacterBase* TargetCharacter, bool bHeadShot)
 {
-	
+	if (!HasAuthority() || !IsValid(TargetCharacter))
+	{
+		return;
+	}
+	INC_DWORD_STAT(STAT_GRBDamageNumberHits);
+
+	// 同一目标并入已有条目; 单批条目数量很小, 线性查找即可
+	FGRBDamageNumberEntry* Entry = PendingDamageNumbers.Entries.FindByPredicate([TargetCharacter](const FGRBDamageNumberEntry& InEntry)
+	{
+		return InEntry.TargetCharacter == TargetCharacter;
+	});
+	if (!Entry)
+	{
+		// 条目满了先把当前批次发出去
+		if (PendingDamageNumbers.Entries.Num() >= FGRBDamageNumberBatch::MaxEntries)
+		{
+			FlushDamageNumbers();
+		}
+		Entry = &PendingDamageNumbers.Entries.AddDefaulted_GetRef();
+		Entry->TargetCharacter = TargetCharacter;
+	}
+	Entry->DamageAmount += DamageAmount;
+	++Entry->HitCount;
+	Entry->bHeadShot |= bHeadShot;
+
+	// 窗口内首次命中时开窗
+	if (!DamageNumberFlushTimerHandle.IsValid())
+	{
+		const float Window = CVarDamageNumberAggregateWindow.GetValueOnGameThread();
+		if (Window > 0.0f)
+		{
+			GetWorldTimerManager().SetTimer(DamageNumberFlushTimerHandle, this, &AGRBPlayerController::FlushDamageNumbers, Window, false);
+		}
+		else
+		{
+			DamageNumberFlushTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &AGRBPlayerController::FlushDamageNumbers);
+		}
+	}
+}
+
+///--@brief 下发当前窗口内聚合的伤害数字--/
+void AGRBPlayerController::FlushDamageNumbers()
+{
+	GetWorldTimerManager().ClearTimer(DamageNumberFlushTimerHandle);
+
+	// 窗口内被销毁的目标不再显示
+	PendingDamageNumbers.Entries.RemoveAllSwap([](const FGRBDamageNumberEntry& InEntry) { return !IsValid(InEntry.TargetCharacter); }, false);
+	if (PendingDamageNumbers.Entries.Num() == 0)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_GRBDamageNumberRPCs);
+	ClientShowDamageNumbers(PendingDamageNumbers);
+	PendingDamageNumbers.Entries.Reset();
 }
 
-bool AGRBPlayerController::ShowDamageNumber_Validate(float DamageAmount, AGRBCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags)
+void AGRBPlayerController::ClientShowDamageNumbers_Implementation(const FGRBDamageNumberBatch& Batch)
 {
-	return true;
+	UGRBHUDWidget* const HUD = GetGRBHUD();
+	if (!HUD)
+	{
+		return;
+	}
+
+	for (const FGRBDamageNumberEntry& Entry : Batch.Entries)
+	{
+		// 目标尚未在本端生成时引用为空
+		if (IsValid(Entry.TargetCharacter))
+		{
+			HUD->ShowAggregatedDamageNumber(Entry.TargetCharacter, Entry.DamageAmount, Entry.HitCount, Entry.bHeadShot);
+		}
+	}
 }
+#pragma endregion
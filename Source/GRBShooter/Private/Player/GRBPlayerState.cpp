@@ -31,7 +31,9 @@ AGRBPlayerState::AGRBPlayerState()
 	// Set PlayerState's NetUpdateFrequency to the same as the Character.
 	// Default is very low for PlayerStates and introduces perceived lag in the ability system.
 	// 100 is probably way too high for a shipping game, you can adjust to fit your needs.
-	NetUpdateFrequency = 100.0f;
+	// 上限保持100以免技能系统体感延迟; 空闲时按自适应频率衰减到下限
+	NetUpdatePolicy = FGRBNetUpdatePolicy(100.0f, 10.0f);
+	NetUpdateFrequency = NetUpdatePolicy.MaxNetUpdateFrequency;
 
 	DeadTag = FGameplayTag::RequestGameplayTag("State.Dead");
 
@@ -42,6 +44,8 @@ void AGRBPlayerState::BeginPlay()
 {
 	Super::BeginPlay();
 
+	NetUpdatePolicy.ApplyTo(this);
+
 	if (m_PlayerStateASCComponent)
 	{
 		// 给 角色属性-生命值变化委托注册一个监听回调
@@ -54,6 +58,27 @@ void AGRBPlayerState::BeginPlay()
 	}
 }
 
+void AGRBPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(UIFlushTimerHandle);
+	if (AGRBPlayerController* const PC = HUDChangedSource.Get())
+	{
+		PC->OnGRBHUDChanged.Remove(HUDChangedDelegateHandle);
+	}
+	HUDChangedSource.Reset();
+	CachedHUD.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float AGRBPlayerState::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float BasePriority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+	// 玩家状态本身没有有效位置, 以其Pawn的位置作为距离参考
+	const AActor* const DistanceActor = GetPawn() ? static_cast<const AActor*>(GetPawn()) : this;
+	return NetUpdatePolicy.ScaleNetPriority(BasePriority, DistanceActor, ViewPos, ViewDir, Viewer, ViewTarget);
+}
+
 UAbilitySystemComponent* AGRBPlayerState::GetAbilitySystemComponent() const
 {
 	return m_PlayerStateASCComponent;
@@ -74,71 +99,139 @@ bool AGRBPlayerState::IsAlive() const
 	return GetHealth() > 0.0f;
 }
 
+#pragma region ~ 交互/确认提示 ~
+// 各提示接口只记录本帧的最终状态, 下一帧统一写进HUD一次; 同帧内反复切换(如逐帧扫描交互目标)只落最后一次
 void AGRBPlayerState::ShowAbilityConfirmPrompt(bool bShowPrompt)
 {
-	AGRBPlayerController* PC = Cast<AGRBPlayerController>(GetOwner());
-	if (PC)
+	if (ScheduleUIFlush())
 	{
-		UGRBHUDWidget* HUD = PC->GetGRBHUD();
-		if (HUD)
-		{
-			HUD->ShowAbilityConfirmPrompt(bShowPrompt);
-		}
+		PendingUI.AbilityConfirmPrompt = bShowPrompt ? EGRBPendingUIOp::Show : EGRBPendingUIOp::Hide;
 	}
 }
 
 void AGRBPlayerState::ShowInteractionPrompt(float InteractionDuration)
 {
-	AGRBPlayerController* PC = Cast<AGRBPlayerController>(GetOwner());
-	if (PC)
+	if (ScheduleUIFlush())
 	{
-		UGRBHUDWidget* HUD = PC->GetGRBHUD();
-		if (HUD)
-		{
-			HUD->ShowInteractionPrompt(InteractionDuration);
-		}
+		PendingUI.InteractionPrompt = EGRBPendingUIOp::Show;
+		PendingUI.InteractionPromptDuration = InteractionDuration;
 	}
 }
 
 void AGRBPlayerState::HideInteractionPrompt()
 {
-	AGRBPlayerController* PC = Cast<AGRBPlayerController>(GetOwner());
-	if (PC)
+	if (ScheduleUIFlush())
 	{
-		UGRBHUDWidget* HUD = PC->GetGRBHUD();
-		if (HUD)
-		{
-			HUD->HideInteractionPrompt();
-		}
+		PendingUI.InteractionPrompt = EGRBPendingUIOp::Hide;
 	}
 }
 
 void AGRBPlayerState::StartInteractionTimer(float InteractionDuration)
 {
-	AGRBPlayerController* PC = Cast<AGRBPlayerController>(GetOwner());
-	if (PC)
+	if (ScheduleUIFlush())
 	{
-		UGRBHUDWidget* HUD = PC->GetGRBHUD();
-		if (HUD)
-		{
-			HUD->StartInteractionTimer(InteractionDuration);
-		}
+		PendingUI.InteractionTimer = EGRBPendingUIOp::Show;
+		PendingUI.InteractionTimerDuration = InteractionDuration;
 	}
 }
 
 void AGRBPlayerState::StopInteractionTimer()
 {
-	AGRBPlayerController* PC = Cast<AGRBPlayerController>(GetOwner());
-	if (PC)
+	if (ScheduleUIFlush())
+	{
+		PendingUI.InteractionTimer = EGRBPendingUIOp::Hide;
+	}
+}
+
+///--@brief 取缓存的HUD; 缓存失效时向控制器重新取一次--/
+UGRBHUDWidget* AGRBPlayerState::GetCachedHUD()
+{
+	if (UGRBHUDWidget* const HUD = CachedHUD.Get())
 	{
-		UGRBHUDWidget* HUD = PC->GetGRBHUD();
-		if (HUD)
+		return HUD;
+	}
+
+	AGRBPlayerController* const PC = Cast<AGRBPlayerController>(GetOwner());
+	if (!PC)
+	{
+		return nullptr;
+	}
+
+	// 订阅HUD重建通知; 控制器换了就改订新的
+	if (HUDChangedSource.Get() != PC)
+	{
+		if (AGRBPlayerController* const OldPC = HUDChangedSource.Get())
 		{
-			HUD->StopInteractionTimer();
+			OldPC->OnGRBHUDChanged.Remove(HUDChangedDelegateHandle);
 		}
+		HUDChangedDelegateHandle = PC->OnGRBHUDChanged.AddUObject(this, &AGRBPlayerState::InvalidateCachedHUD);
+		HUDChangedSource = PC;
+	}
+
+	CachedHUD = PC->GetGRBHUD();
+	return CachedHUD.Get();
+}
+
+///--@brief HUD被重建, 作废缓存--/
+void AGRBPlayerState::InvalidateCachedHUD()
+{
+	CachedHUD.Reset();
+}
+
+///--@brief 本帧首次有提示变化时, 排一次下一帧的统一刷新; 非本地玩家直接丢弃--/
+bool AGRBPlayerState::ScheduleUIFlush()
+{
+	const AGRBPlayerController* const PC = Cast<AGRBPlayerController>(GetOwner());
+	if (!PC || !PC->IsLocalController())
+	{
+		return false;
+	}
+
+	if (!UIFlushTimerHandle.IsValid())
+	{
+		UIFlushTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &AGRBPlayerState::FlushPendingUI);
 	}
+	return true;
 }
 
+///--@brief 把累积的提示变化一次性写进HUD--/
+void AGRBPlayerState::FlushPendingUI()
+{
+	UIFlushTimerHandle.Invalidate();
+	const FGRBPendingUIState State = PendingUI;
+	PendingUI = FGRBPendingUIState();
+
+	UGRBHUDWidget* const HUD = GetCachedHUD();
+	if (!HUD)
+	{
+		return;
+	}
+
+	if (State.AbilityConfirmPrompt != EGRBPendingUIOp::None)
+	{
+		HUD->ShowAbilityConfirmPrompt(State.AbilityConfirmPrompt == EGRBPendingUIOp::Show);
+	}
+
+	if (State.InteractionPrompt == EGRBPendingUIOp::Show)
+	{
+		HUD->ShowInteractionPrompt(State.InteractionPromptDuration);
+	}
+	else if (State.InteractionPrompt == EGRBPendingUIOp::Hide)
+	{
+		HUD->HideInteractionPrompt();
+	}
+
+	if (State.InteractionTimer == EGRBPendingUIOp::Show)
+	{
+		HUD->StartInteractionTimer(State.InteractionTimerDuration);
+	}
+	else if (State.InteractionTimer == EGRBPendingUIOp::Hide)
+	{
+		HUD->StopInteractionTimer();
+	}
+}
+#pragma endregion
+
 #pragma region ~ 对外预留的一些属性集Getter接口 ~
 float AGRBPlayerState::GetHealth() const
 {
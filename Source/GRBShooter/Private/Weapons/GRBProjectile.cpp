@@ -8,9 +8,12 @@
 #include "Characters/Abilities/GRBAbilitySystemComponent.h"
 #include "Characters/Heroes/GRBHeroCharacter.h"
 #include "GameFramework/ProjectileMovementComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "GameFramework/PlayerState.h"
+#include "Net/UnrealNetwork.h"
+#include "Weapons/GRBProjectileManagerSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Explosion"), STAT_GRBProjectile_Explosion, STATGROUP_GRBProjectile);
+DECLARE_CYCLE_STAT(TEXT("Projectile Explosion LineOfSight"), STAT_GRBProjectile_ExplosionLineOfSight, STATGROUP_GRBProjectile);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Explosion Targets"), STAT_GRBProjectile_ExplosionTargets, STATGROUP_GRBProjectile);
 
 
 // Sets default values
@@ -25,64 +28,102 @@ AGRBProjectile::AGRBProjectile()
 
 	bReplicates = true;
 
-	//TODO change this to a better value
-	NetUpdateFrequency = 100.0f;
-
-
-	ProjectileMovement->bIsHomingProjectile = mIsHoming;
-	if (mHomingTarget)
-	{
-		ProjectileMovement->HomingTargetComponent = mHomingTarget->GetRootComponent();
-	}
+	// 客户端自行模拟弹道, 服务端只需低频纠正; 远处/视野背后的观察者进一步降低优先级
+	// 裁剪距离沿用Actor默认值, 射程之外的覆盖见 IsNetRelevantFor
+	NetUpdatePolicy = FGRBNetUpdatePolicy(30.0f, 10.0f);
+	NetUpdateFrequency = NetUpdatePolicy.MaxNetUpdateFrequency;
 }
 
 void AGRBProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (AGRBHeroCharacter* GRBHero = Cast<AGRBHeroCharacter>(GetInstigator()))
+	NetUpdatePolicy.ApplyTo(this);
+
+	// 生成时未传入ASC(例如蓝图直接生成)则退回到开火者自身的ASC; 不再做任何全局查找
+	if (!mGRBASC)
 	{
-		APlayerState* PS = UGameplayStatics::GetPlayerController(this, 0)->PlayerState.Get();
-		UAbilitySystemComponent* NowASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Cast<AActor>(PS));
-		if (UGRBAbilitySystemComponent* PASC = Cast<UGRBAbilitySystemComponent>(NowASC))
+		mGRBASC = UGRBAbilitySystemComponent::GetAbilitySystemComponentFromActor(GetInstigator());
+	}
+
+	// 追踪参数在生成时才确定, 故在此处而非构造函数里交给移动组件
+	if (mIsHoming && mHomingTarget)
+	{
+		mHomingAimPoint = NewObject<USceneComponent>(this, FName("HomingAimPoint"));
+		mHomingAimPoint->SetUsingAbsoluteLocation(true);
+		mHomingAimPoint->RegisterComponent();
+		ProjectileMovement->bIsHomingProjectile = true;
+		ProjectileMovement->HomingTargetComponent = mHomingAimPoint;
+		if (UGRBProjectileManagerSubsystem* const ProjectileManager = GetWorld()->GetSubsystem<UGRBProjectileManagerSubsystem>())
 		{
-			mGRBASC = PASC;
-			if (!GRBHero->IsLocallyControlled())
-			{
-				const FGameplayTag& CueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.RocketLauncher.Fire"));
-				const FGameplayEffectContextHandle& EmptyEffectContextHandle = FGameplayEffectContextHandle();
-				const FVector& CueLocation = GetActorLocation();
-				const FVector& CueNormal = UKismetMathLibrary::GetForwardVector(GetActorRotation());
-				const AActor* CueInstigator = GRBHero;
-				const FGameplayCueParameters& CueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, EmptyEffectContextHandle,
-				                                                                                                        FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
-				                                                                                                        FGameplayTagContainer(), CueLocation, CueNormal,
-				                                                                                                        const_cast<AActor*>(CueInstigator), nullptr, nullptr,
-				                                                                                                        nullptr, 1, 1,
-				                                                                                                        nullptr, false);
-				mGRBASC->ExecuteGameplayCueLocal(CueTag, CueParameters);
-			}
+			ProjectileManager->RegisterHomingProjectile(this);
 		}
 	}
+
+	// 主控端已在开火技能里本地播放过开火Cue
+	AGRBHeroCharacter* const GRBHero = Cast<AGRBHeroCharacter>(GetInstigator());
+	if (mGRBASC && GRBHero && !GRBHero->IsLocallyControlled())
+	{
+		static const FGameplayTag FireCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.RocketLauncher.Fire"));
+		mGRBASC->ExecuteGameplayCueLocal(FireCueTag, mFireCueParameters);
+	}
 }
 
 void AGRBProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	const FGameplayTag& CueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.RocketLauncher.Impact"));
-	const FGameplayEffectContextHandle& EmptyEffectContextHandle = FGameplayEffectContextHandle();
-	const FVector& CueLocation = GetActorLocation();
-	const FVector& CueNormal = FVector::ZeroVector;
-	const AActor* CueInstigator = nullptr;
-	const FGameplayCueParameters& CueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, EmptyEffectContextHandle,
-	                                                                                                        FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
-	                                                                                                        FGameplayTagContainer(), CueLocation, CueNormal,
-	                                                                                                        const_cast<AActor*>(CueInstigator), nullptr, nullptr,
-	                                                                                                        nullptr, 1, 1,
-	                                                                                                        nullptr, false);
-	mGRBASC->ExecuteGameplayCueLocal(CueTag, CueParameters);
+	if (mHomingAimPoint)
+	{
+		if (UGRBProjectileManagerSubsystem* const ProjectileManager = GetWorld()->GetSubsystem<UGRBProjectileManagerSubsystem>())
+		{
+			ProjectileManager->UnregisterHomingProjectile(this);
+		}
+	}
+
+	if (mGRBASC)
+	{
+		static const FGameplayTag ImpactCueTag = FGameplayTag::RequestGameplayTag(FName("GameplayCue.Weapon.RocketLauncher.Impact"));
+		const FGameplayEffectContextHandle& EmptyEffectContextHandle = FGameplayEffectContextHandle();
+		const FVector& CueLocation = GetActorLocation();
+		const FVector& CueNormal = FVector::ZeroVector;
+		const AActor* CueInstigator = nullptr;
+		const FGameplayCueParameters& CueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, EmptyEffectContextHandle,
+		                                                                                                        FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
+		                                                                                                        FGameplayTagContainer(), CueLocation, CueNormal,
+		                                                                                                        const_cast<AActor*>(CueInstigator), nullptr, nullptr,
+		                                                                                                        nullptr, 1, 1,
+		                                                                                                        nullptr, false);
+		mGRBASC->ExecuteGameplayCueLocal(ImpactCueTag, CueParameters);
+	}
 	Super::EndPlay(EndPlayReason);
 }
 
+void AGRBProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(AGRBProjectile, mGRBASC, COND_InitialOnly);
+	DOREPLIFETIME_CONDITION(AGRBProjectile, mFireCueParameters, COND_InitialOnly);
+	DOREPLIFETIME_CONDITION(AGRBProjectile, mIsHoming, COND_InitialOnly);
+	DOREPLIFETIME_CONDITION(AGRBProjectile, mHomingTarget, COND_InitialOnly);
+}
+
+float AGRBProjectile::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float BasePriority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+	return NetUpdatePolicy.ScaleNetPriority(BasePriority, this, ViewPos, ViewDir, Viewer, ViewTarget);
+}
+
+///--@brief 火箭没有射程上限: 除了自身附近的观察者, 凡是开火者对其相关的观察者也能收到, 不会在长距离飞行途中被裁掉--/
+bool AGRBProjectile::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	if (Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation))
+	{
+		return true;
+	}
+	const APawn* const ProjectileInstigator = GetInstigator();
+	return ProjectileInstigator && ProjectileInstigator != this && ProjectileInstigator->IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+}
+
 void AGRBProjectile::OnSphereCompOvlp(AActor* InOtherActor)
 {
 	if (!HasAuthority())
@@ -93,31 +134,71 @@ void AGRBProjectile::OnSphereCompOvlp(AActor* InOtherActor)
 	{
 		if (GetInstigator() != InOtherActor)
 		{
-			TArray<FHitResult> OutHitResults;
-			TArray<TEnumAsByte<EObjectTypeQuery>> PTypes;
-			PTypes.AddUnique(UEngineTypes::ConvertToObjectType(ECC_Pawn));
-			TArray<AActor*> IgnoreActors;
-			UKismetSystemLibrary::SphereTraceMultiForObjects(this, GetActorLocation(), GetActorLocation() + FVector(0.01, 0.01, 0.01), mExplosionRadius,
-			                                                 PTypes, false, IgnoreActors, EDrawDebugTrace::None, OutHitResults, true, FColor::Red, FColor::Green, 5.0f);
-			for (FHitResult& PerHit : OutHitResults)
+			// 爆炸命中单独收集, 再并入生成时预先传入的目标(去重), 不覆盖 mHitTargets
+			TArray<AGRBCharacterBase*> ExplosionTargets;
+			CollectExplosionTargets(GetWorld(), GetActorLocation(), mExplosionRadius, mExplosionRequiresLineOfSight, ExplosionTargets);
+			for (AGRBCharacterBase* const ExplosionTarget : ExplosionTargets)
 			{
-				if (AGRBCharacterBase* GRBCharacterBase = Cast<AGRBCharacterBase>(PerHit.GetActor()))
-				{
-					if (GRBCharacterBase->IsAlive())
-					{
-						mHitTargets.AddUnique(GRBCharacterBase);
-					}
-				}
+				mHitTargets.AddUnique(ExplosionTarget);
 			}
 
-			TArray<AActor*> pTargetActors;
-			for (AGRBCharacterBase* PawnBase : mHitTargets)
-			{
-				pTargetActors.AddUnique(PawnBase);
-			}
+			TArray<AActor*> pTargetActors(mHitTargets);
 			UGRBBlueprintFunctionLibrary::AddTargetsToEffectContainerSpec(mGRBGEContainerSpecPak, TArray<FGameplayAbilityTargetDataHandle>(), TArray<FHitResult>(), pTargetActors);
 			UGRBBlueprintFunctionLibrary::ApplyExternalEffectContainerSpec(mGRBGEContainerSpecPak);
 			K2_DestroyActor();
 		}
 	}
 }
+
+///--@brief 爆炸索敌: 一次球形重叠查询收集存活的GRB角色并去重; 可选地再做一轮批量视线遮挡检测--/
+void AGRBProjectile::CollectExplosionTargets(const UWorld* InWorld, const FVector& InOrigin, float InRadius, bool bInRequireLineOfSight, TArray<AGRBCharacterBase*>& OutTargets)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBProjectile_Explosion);
+
+	OutTargets.Reset();
+	if (!InWorld || InRadius <= 0.0f)
+	{
+		return;
+	}
+
+	// 预构建的对象类型查询, 只关心Pawn; 直接做重叠而非零长度的球形扫掠
+	static const FCollisionObjectQueryParams PawnObjectQueryParams(ECC_Pawn);
+	TArray<FOverlapResult> Overlaps;
+	InWorld->OverlapMultiByObjectType(Overlaps, InOrigin, FQuat::Identity, PawnObjectQueryParams, FCollisionShape::MakeSphere(InRadius), FCollisionQueryParams(SCENE_QUERY_STAT(GRBProjectileExplosion), false));
+
+	// 一个角色可能有多个图元同时重叠, 用集合去重
+	TSet<AGRBCharacterBase*> UniqueTargets;
+	UniqueTargets.Reserve(Overlaps.Num());
+	OutTargets.Reserve(Overlaps.Num());
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		AGRBCharacterBase* const GRBCharacterBase = Cast<AGRBCharacterBase>(Overlap.GetActor());
+		if (GRBCharacterBase && GRBCharacterBase->IsAlive())
+		{
+			bool bAlreadyInSet = false;
+			UniqueTargets.Add(GRBCharacterBase, &bAlreadyInSet);
+			if (!bAlreadyInSet)
+			{
+				OutTargets.Add(GRBCharacterBase);
+			}
+		}
+	}
+
+	// 视线遮挡: 整批共用一份查询参数, 只对静态几何做一轮射线测试
+	if (bInRequireLineOfSight && OutTargets.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GRBProjectile_ExplosionLineOfSight);
+
+		static const FCollisionObjectQueryParams OccluderObjectQueryParams(ECC_WorldStatic);
+		const FCollisionQueryParams LineOfSightParams(SCENE_QUERY_STAT(GRBProjectileExplosionLineOfSight), false);
+		for (int32 Index = OutTargets.Num() - 1; Index >= 0; --Index)
+		{
+			if (InWorld->LineTraceTestByObjectType(InOrigin, OutTargets[Index]->GetActorLocation(), OccluderObjectQueryParams, LineOfSightParams))
+			{
+				OutTargets.RemoveAtSwap(Index, 1, false);
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_GRBProjectile_ExplosionTargets, OutTargets.Num());
+}
@@ -0,0 +1,506 @@
+// Copyright 2024 GRB.
+
+
+#include "Weapons/GRBProjectileManagerSubsystem.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "GRBBlueprintFunctionLibrary.h"
+#include "Characters/GRBCharacterBase.h"
+#include "Characters/Abilities/GRBAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Weapons/GRBProjectile.h"
+
+DECLARE_CYCLE_STAT(TEXT("ProjectileManager Tick"), STAT_GRBProjectileManager_Tick, STATGROUP_GRBProjectile);
+DECLARE_CYCLE_STAT(TEXT("ProjectileManager Homing"), STAT_GRBProjectileManager_Homing, STATGROUP_GRBProjectile);
+DECLARE_CYCLE_STAT(TEXT("ProjectileManager Homing AimPoints"), STAT_GRBProjectileManager_HomingAimPoints, STATGROUP_GRBProjectile);
+DECLARE_CYCLE_STAT(TEXT("ProjectileManager Integrate"), STAT_GRBProjectileManager_Integrate, STATGROUP_GRBProjectile);
+DECLARE_CYCLE_STAT(TEXT("ProjectileManager Sweep"), STAT_GRBProjectileManager_Sweep, STATGROUP_GRBProjectile);
+DECLARE_CYCLE_STAT(TEXT("ProjectileManager Impact"), STAT_GRBProjectileManager_Impact, STATGROUP_GRBProjectile);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Projectiles"), STAT_GRBProjectileManager_NumSimulated, STATGROUP_GRBProjectile);
+
+static TAutoConsoleVariable<int32> CVarProjectileMaxSimulated(
+	TEXT("GRB.projectile.MaxSimulated"),
+	1024,
+	TEXT("Upper bound of lightweight projectiles simulated at once by the projectile manager")
+);
+
+static TAutoConsoleVariable<float> CVarProjectileHomingUpdateRate(
+	TEXT("GRB.projectile.HomingUpdateRate"),
+	10.0f,
+	TEXT("How many times per second homing aim points are re-extrapolated from their targets (<= 0 updates every frame)")
+);
+
+static TAutoConsoleVariable<float> CVarProjectileHomingMaxLeadTime(
+	TEXT("GRB.projectile.HomingMaxLeadTime"),
+	0.5f,
+	TEXT("Upper bound in seconds of the lead time used when extrapolating a homing target")
+);
+
+#pragma region ~ UGRBProjectileManagerSubsystem ~
+bool UGRBProjectileManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGRBProjectileManagerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 仅联网的服务端需要复制器; 单机和客户端都不生成
+	const ENetMode NetMode = InWorld.GetNetMode();
+	if (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		RegisterReplicator(InWorld.SpawnActor<AGRBProjectileReplicator>(AGRBProjectileReplicator::StaticClass(), SpawnParameters));
+	}
+}
+
+void UGRBProjectileManagerSubsystem::Deinitialize()
+{
+	ProjectileIds.Empty();
+	Positions.Empty();
+	PrevPositions.Empty();
+	Velocities.Empty();
+	GravityScales.Empty();
+	CollisionRadii.Empty();
+	RemainingLifeSpans.Empty();
+	HomingAccelerations.Empty();
+	HomingTargets.Empty();
+	HomingAimPoints.Empty();
+	HomingActorProjectiles.Empty();
+	Instigators.Empty();
+	InstigatorASCs.Empty();
+	ImpactCueTags.Empty();
+	ExplosionRadii.Empty();
+	EffectContainerSpecs.Empty();
+	PendingSpawnEvents.Empty();
+	Replicator.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UGRBProjectileManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGRBProjectileManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UGRBProjectileManagerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBProjectileManager_Tick);
+
+	FlushPendingSpawnEvents();
+	UpdateHomingAimPoints(DeltaTime);
+
+	if (ProjectileIds.Num() == 0)
+	{
+		return;
+	}
+
+	UpdateHoming(DeltaTime);
+	IntegrateProjectiles(DeltaTime);
+
+	TArray<int32> ImpactIndices;
+	TArray<FHitResult> ImpactHits;
+	SweepProjectiles(ImpactIndices, ImpactHits);
+
+	// 超时的弹丸视作在当前位置爆炸
+	TBitArray<> ImpactFlags(false, ProjectileIds.Num());
+	for (const int32 Index : ImpactIndices)
+	{
+		ImpactFlags[Index] = true;
+	}
+	for (int32 Index = 0; Index < RemainingLifeSpans.Num(); ++Index)
+	{
+		if (RemainingLifeSpans[Index] <= 0.0f && !ImpactFlags[Index])
+		{
+			FHitResult ExpiredHit;
+			ExpiredHit.Location = Positions[Index];
+			ExpiredHit.ImpactPoint = Positions[Index];
+			ImpactIndices.Add(Index);
+			ImpactHits.Add(ExpiredHit);
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GRBProjectileManager_Impact);
+		for (int32 i = 0; i < ImpactIndices.Num(); ++i)
+		{
+			ResolveImpact(ImpactIndices[i], ImpactHits[i]);
+		}
+	}
+
+	// 从后往前交换删除, 避免前面的行号失效
+	ImpactIndices.Sort(TGreater<int32>());
+	for (const int32 Index : ImpactIndices)
+	{
+		RemoveProjectileAtSwap(Index);
+	}
+
+	// 扫掠完毕后才推进上一帧位置; 新生成且补过帧的弹丸由此在首次扫掠中覆盖整段补帧路径
+	PrevPositions = Positions;
+
+	SET_DWORD_STAT(STAT_GRBProjectileManager_NumSimulated, ProjectileIds.Num());
+}
+
+///--@brief 服务端生成一枚轻量弹丸, 返回其ID; 客户端调用无效返回0--/
+int32 UGRBProjectileManagerSubsystem::SpawnProjectile(const FGRBProjectileSpawnParams& InParams)
+{
+	UWorld* const World = GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return 0;
+	}
+
+	if (ProjectileIds.Num() >= CVarProjectileMaxSimulated.GetValueOnGameThread())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Warning: UGRBProjectileManagerSubsystem::SpawnProjectile, reached GRB.projectile.MaxSimulated, spawn skipped"));
+		return 0;
+	}
+
+	FGRBProjectileSpawnEvent SpawnEvent;
+	SpawnEvent.ProjectileId = NextProjectileId++;
+	SpawnEvent.Origin = InParams.Origin;
+	SpawnEvent.Velocity = InParams.Direction.GetSafeNormal() * InParams.Speed;
+	SpawnEvent.GravityScale = InParams.GravityScale;
+	SpawnEvent.CollisionRadius = InParams.CollisionRadius;
+	SpawnEvent.LifeSpan = InParams.LifeSpan;
+	SpawnEvent.HomingAccelerationMagnitude = InParams.HomingAccelerationMagnitude;
+	SpawnEvent.HomingTarget = InParams.HomingTarget;
+	SpawnEvent.Instigator = InParams.Instigator;
+	SpawnEvent.ImpactCueTag = InParams.ImpactCueTag;
+	SpawnEvent.ServerSpawnTime = GetServerWorldTimeSeconds();
+
+	const int32 Index = AddSimulatedProjectile(SpawnEvent, 0.0f);
+	ExplosionRadii[Index] = InParams.ExplosionRadius;
+	EffectContainerSpecs[Index] = InParams.EffectContainerSpec;
+	if (InParams.InstigatorASC)
+	{
+		InstigatorASCs[Index] = InParams.InstigatorASC;
+	}
+
+	if (Replicator.IsValid())
+	{
+		PendingSpawnEvents.Add(SpawnEvent);
+	}
+
+	return static_cast<int32>(SpawnEvent.ProjectileId);
+}
+
+///--@brief 客户端收到服务端打包的出生事件后进入--/
+void UGRBProjectileManagerSubsystem::ReceiveSpawnEvents(const TArray<FGRBProjectileSpawnEvent>& InSpawnEvents)
+{
+	const float ServerNow = GetServerWorldTimeSeconds();
+	for (const FGRBProjectileSpawnEvent& SpawnEvent : InSpawnEvents)
+	{
+		if (ProjectileIds.Num() >= CVarProjectileMaxSimulated.GetValueOnGameThread())
+		{
+			break;
+		}
+		// 按照服务端出生时刻补帧, 让客户端表现追上服务端
+		const float FastForward = FMath::Max(0.0f, ServerNow - SpawnEvent.ServerSpawnTime);
+		AddSimulatedProjectile(SpawnEvent, FastForward);
+	}
+}
+
+///--@brief 复制器Actor开始运作时登记到本管理器--/
+void UGRBProjectileManagerSubsystem::RegisterReplicator(AGRBProjectileReplicator* InReplicator)
+{
+	Replicator = InReplicator;
+}
+
+///--@brief 把一条出生事件落成SoA里的一行; InFastForward为需要补帧的时长--/
+int32 UGRBProjectileManagerSubsystem::AddSimulatedProjectile(const FGRBProjectileSpawnEvent& InSpawnEvent, float InFastForward)
+{
+	const float GravityZ = GetWorld() ? GetWorld()->GetGravityZ() : 0.0f;
+	const FVector Gravity(0.0f, 0.0f, GravityZ * InSpawnEvent.GravityScale);
+	const FVector Origin = InSpawnEvent.Origin;
+	const FVector Velocity = InSpawnEvent.Velocity;
+
+	// 补帧段按匀加速直线处理; 上一帧位置保留在出生点
+	const FVector FastForwardPosition = Origin + Velocity * InFastForward + 0.5f * Gravity * FMath::Square(InFastForward);
+	const FVector FastForwardVelocity = Velocity + Gravity * InFastForward;
+
+	AActor* const InstigatorActor = InSpawnEvent.Instigator;
+
+	ProjectileIds.Add(InSpawnEvent.ProjectileId);
+	Positions.Add(FastForwardPosition);
+	PrevPositions.Add(Origin);
+	Velocities.Add(FastForwardVelocity);
+	GravityScales.Add(InSpawnEvent.GravityScale);
+	CollisionRadii.Add(InSpawnEvent.CollisionRadius);
+	RemainingLifeSpans.Add(InSpawnEvent.LifeSpan - InFastForward);
+	HomingAccelerations.Add(InSpawnEvent.HomingAccelerationMagnitude);
+	HomingTargets.Add(InSpawnEvent.HomingTarget);
+	HomingAimPoints.Add(InSpawnEvent.HomingTarget ? ExtrapolateHomingAimPoint(InSpawnEvent.HomingTarget, FastForwardPosition, FastForwardVelocity.Size()) : FastForwardPosition);
+	Instigators.Add(InstigatorActor);
+	InstigatorASCs.Add(UGRBAbilitySystemComponent::GetAbilitySystemComponentFromActor(InstigatorActor));
+	ImpactCueTags.Add(InSpawnEvent.ImpactCueTag);
+	ExplosionRadii.Add(0.0f);
+	return EffectContainerSpecs.Add(FGRBGameplayEffectContainerSpec());
+}
+
+///--@brief 登记一枚Actor形态的追踪弹, 由本管理器统一按低频刷新其追踪瞄点--/
+void UGRBProjectileManagerSubsystem::RegisterHomingProjectile(AGRBProjectile* InProjectile)
+{
+	if (!InProjectile || !InProjectile->mHomingAimPoint)
+	{
+		return;
+	}
+	HomingActorProjectiles.AddUnique(InProjectile);
+
+	// 登记时立即给出一次瞄点, 不必等到下一轮刷新
+	const float Speed = InProjectile->ProjectileMovement->Velocity.IsNearlyZero() ? InProjectile->ProjectileMovement->InitialSpeed : InProjectile->ProjectileMovement->Velocity.Size();
+	InProjectile->mHomingAimPoint->SetWorldLocation(ExtrapolateHomingAimPoint(InProjectile->mHomingTarget, InProjectile->GetActorLocation(), Speed));
+}
+
+///--@brief 注销Actor形态的追踪弹--/
+void UGRBProjectileManagerSubsystem::UnregisterHomingProjectile(AGRBProjectile* InProjectile)
+{
+	HomingActorProjectiles.RemoveSwap(InProjectile, false);
+}
+
+///--@brief 按目标当前速度外推出追踪瞄点; 提前量取弹丸飞抵目标的预估时长, 并受最大提前量约束--/
+FVector UGRBProjectileManagerSubsystem::ExtrapolateHomingAimPoint(const AActor* InTarget, const FVector& InProjectileLocation, float InProjectileSpeed)
+{
+	if (!InTarget)
+	{
+		return InProjectileLocation;
+	}
+	const FVector TargetLocation = InTarget->GetActorLocation();
+	const float TimeToTarget = InProjectileSpeed > KINDA_SMALL_NUMBER ? FVector::Dist(TargetLocation, InProjectileLocation) / InProjectileSpeed : 0.0f;
+	const float LeadTime = FMath::Min(TimeToTarget, CVarProjectileHomingMaxLeadTime.GetValueOnGameThread());
+	return TargetLocation + InTarget->GetVelocity() * LeadTime;
+}
+
+///--@brief 按 GRB.projectile.HomingUpdateRate 的频率, 一次遍历刷新所有追踪弹(轻量与Actor两种形态)的追踪瞄点--/
+void UGRBProjectileManagerSubsystem::UpdateHomingAimPoints(float DeltaTime)
+{
+	const float UpdateRate = CVarProjectileHomingUpdateRate.GetValueOnGameThread();
+	HomingUpdateAccumulator += DeltaTime;
+	if (UpdateRate > 0.0f && HomingUpdateAccumulator < 1.0f / UpdateRate)
+	{
+		return;
+	}
+	HomingUpdateAccumulator = 0.0f;
+
+	SCOPE_CYCLE_COUNTER(STAT_GRBProjectileManager_HomingAimPoints);
+
+	// 轻量弹丸
+	const int32 Num = ProjectileIds.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (HomingAccelerations[Index] > 0.0f)
+		{
+			if (const AActor* const Target = HomingTargets[Index].Get())
+			{
+				HomingAimPoints[Index] = ExtrapolateHomingAimPoint(Target, Positions[Index], Velocities[Index].Size());
+			}
+		}
+	}
+
+	// Actor形态的追踪弹; 顺手清掉已失效的登记
+	for (int32 Index = HomingActorProjectiles.Num() - 1; Index >= 0; --Index)
+	{
+		AGRBProjectile* const Projectile = HomingActorProjectiles[Index].Get();
+		if (!Projectile || !Projectile->mHomingAimPoint)
+		{
+			HomingActorProjectiles.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+		if (Projectile->mHomingTarget)
+		{
+			Projectile->mHomingAimPoint->SetWorldLocation(ExtrapolateHomingAimPoint(Projectile->mHomingTarget, Projectile->GetActorLocation(), Projectile->ProjectileMovement->Velocity.Size()));
+		}
+	}
+}
+
+///--@brief 追踪转向; 每帧只朝缓存的瞄点转向, 不访问目标Actor--/
+void UGRBProjectileManagerSubsystem::UpdateHoming(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBProjectileManager_Homing);
+
+	const int32 Num = ProjectileIds.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (HomingAccelerations[Index] <= 0.0f || !HomingTargets[Index].IsValid())
+		{
+			continue;
+		}
+
+		// 与 UProjectileMovementComponent::ComputeHomingAcceleration 一致, 但保持速率不变, 只改朝向
+		FVector& Velocity = Velocities[Index];
+		const float Speed = Velocity.Size();
+		const FVector Acceleration = (HomingAimPoints[Index] - Positions[Index]).GetSafeNormal() * HomingAccelerations[Index];
+		Velocity = (Velocity + Acceleration * DeltaTime).GetSafeNormal() * Speed;
+	}
+}
+
+///--@brief 积分步; 对连续数组做一次线性遍历--/
+void UGRBProjectileManagerSubsystem::IntegrateProjectiles(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBProjectileManager_Integrate);
+
+	const float GravityZDelta = GetWorld()->GetGravityZ() * DeltaTime;
+	const int32 Num = ProjectileIds.Num();
+
+	FVector* RESTRICT PositionData = Positions.GetData();
+	FVector* RESTRICT VelocityData = Velocities.GetData();
+	const float* RESTRICT GravityScaleData = GravityScales.GetData();
+	float* RESTRICT LifeSpanData = RemainingLifeSpans.GetData();
+
+	// 无分支的紧凑循环, 便于编译器做自动向量化
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		VelocityData[Index].Z += GravityZDelta * GravityScaleData[Index];
+		PositionData[Index] += VelocityData[Index] * DeltaTime;
+		LifeSpanData[Index] -= DeltaTime;
+	}
+}
+
+///--@brief 扫掠检测; 每行一次球形扫掠, 输出命中的行号及命中结果--/
+void UGRBProjectileManagerSubsystem::SweepProjectiles(TArray<int32>& OutImpactIndices, TArray<FHitResult>& OutImpactHits)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBProjectileManager_Sweep);
+
+	UWorld* const World = GetWorld();
+	static const FName ProjectileProfileName(TEXT("Projectile"));
+
+	// 整批共用一份查询参数, 每行只替换忽略的开火者
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GRBProjectileManagerSweep), false);
+	const int32 Num = ProjectileIds.Num();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		QueryParams.ClearIgnoredActors();
+		if (AActor* const InstigatorActor = Instigators[Index].Get())
+		{
+			QueryParams.AddIgnoredActor(InstigatorActor);
+		}
+
+		FHitResult Hit;
+		if (World->SweepSingleByProfile(Hit, PrevPositions[Index], Positions[Index], FQuat::Identity, ProjectileProfileName, FCollisionShape::MakeSphere(CollisionRadii[Index]), QueryParams))
+		{
+			OutImpactIndices.Add(Index);
+			OutImpactHits.Add(Hit);
+		}
+	}
+}
+
+///--@brief 处理一次命中: 双端播放Cue, 服务端结算爆炸伤害--/
+void UGRBProjectileManagerSubsystem::ResolveImpact(int32 InIndex, const FHitResult& InImpactHit)
+{
+	const FVector ImpactLocation = InImpactHit.bBlockingHit ? FVector(InImpactHit.Location) : Positions[InIndex];
+
+	// 命中特效; 专用服务器没有表现, 不播放
+	UGRBAbilitySystemComponent* const GRBASC = InstigatorASCs[InIndex].Get();
+	if (GRBASC && ImpactCueTags[InIndex].IsValid() && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		const FGameplayCueParameters& CueParameters = UAbilitySystemBlueprintLibrary::MakeGameplayCueParameters(0, 0, FGameplayEffectContextHandle(),
+		                                                                                                        FGameplayTag::EmptyTag, FGameplayTag::EmptyTag, FGameplayTagContainer(),
+		                                                                                                        FGameplayTagContainer(), ImpactLocation, FVector(InImpactHit.ImpactNormal),
+		                                                                                                        Instigators[InIndex].Get(), nullptr, nullptr,
+		                                                                                                        nullptr, 1, 1,
+		                                                                                                        nullptr, false);
+		GRBASC->ExecuteGameplayCueLocal(ImpactCueTags[InIndex], CueParameters);
+	}
+
+	// 爆炸伤害只在服务端结算
+	if (GetWorld()->GetNetMode() == NM_Client || ExplosionRadii[InIndex] <= 0.0f)
+	{
+		return;
+	}
+
+	TArray<AGRBCharacterBase*> HitTargets;
+	AGRBProjectile::CollectExplosionTargets(GetWorld(), ImpactLocation, ExplosionRadii[InIndex], false, HitTargets);
+	TArray<AActor*> pTargetActors(HitTargets);
+
+	if (pTargetActors.Num() > 0)
+	{
+		FGRBGameplayEffectContainerSpec& ContainerSpec = EffectContainerSpecs[InIndex];
+		UGRBBlueprintFunctionLibrary::AddTargetsToEffectContainerSpec(ContainerSpec, TArray<FGameplayAbilityTargetDataHandle>(), TArray<FHitResult>(), pTargetActors);
+		UGRBBlueprintFunctionLibrary::ApplyExternalEffectContainerSpec(ContainerSpec);
+	}
+}
+
+///--@brief 以交换删除的方式移除一行, 保持数组连续--/
+void UGRBProjectileManagerSubsystem::RemoveProjectileAtSwap(int32 InIndex)
+{
+	ProjectileIds.RemoveAtSwap(InIndex, 1, false);
+	Positions.RemoveAtSwap(InIndex, 1, false);
+	PrevPositions.RemoveAtSwap(InIndex, 1, false);
+	Velocities.RemoveAtSwap(InIndex, 1, false);
+	GravityScales.RemoveAtSwap(InIndex, 1, false);
+	CollisionRadii.RemoveAtSwap(InIndex, 1, false);
+	RemainingLifeSpans.RemoveAtSwap(InIndex, 1, false);
+	HomingAccelerations.RemoveAtSwap(InIndex, 1, false);
+	HomingTargets.RemoveAtSwap(InIndex, 1, false);
+	HomingAimPoints.RemoveAtSwap(InIndex, 1, false);
+	Instigators.RemoveAtSwap(InIndex, 1, false);
+	InstigatorASCs.RemoveAtSwap(InIndex, 1, false);
+	ImpactCueTags.RemoveAtSwap(InIndex, 1, false);
+	ExplosionRadii.RemoveAtSwap(InIndex, 1, false);
+	EffectContainerSpecs.RemoveAtSwap(InIndex, 1, false);
+}
+
+///--@brief 把本帧累计的出生事件一次性交给复制器发出--/
+void UGRBProjectileManagerSubsystem::FlushPendingSpawnEvents()
+{
+	if (PendingSpawnEvents.Num() == 0)
+	{
+		return;
+	}
+	if (AGRBProjectileReplicator* const pReplicator = Replicator.Get())
+	{
+		pReplicator->MulticastSpawnProjectiles(PendingSpawnEvents);
+	}
+	PendingSpawnEvents.Reset();
+}
+
+float UGRBProjectileManagerSubsystem::GetServerWorldTimeSeconds() const
+{
+	const UWorld* const World = GetWorld();
+	if (const AGameStateBase* const GameState = World ? World->GetGameState() : nullptr)
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+	return World ? World->GetTimeSeconds() : 0.0f;
+}
+#pragma endregion
+
+
+#pragma region ~ AGRBProjectileReplicator ~
+AGRBProjectileReplicator::AGRBProjectileReplicator()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+	// 本体没有需要比较的属性, 只承载多播
+	NetUpdateFrequency = 30.0f;
+}
+
+void AGRBProjectileReplicator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UGRBProjectileManagerSubsystem* const ProjectileManager = GetWorld()->GetSubsystem<UGRBProjectileManagerSubsystem>())
+	{
+		ProjectileManager->RegisterReplicator(this);
+	}
+}
+
+void AGRBProjectileReplicator::MulticastSpawnProjectiles_Implementation(const TArray<FGRBProjectileSpawnEvent>& InSpawnEvents)
+{
+	// 服务端(含主机)已经在 SpawnProjectile 时落好了模拟数据
+	if (HasAuthority())
+	{
+		return;
+	}
+	if (UGRBProjectileManagerSubsystem* const ProjectileManager = GetWorld()->GetSubsystem<UGRBProjectileManagerSubsystem>())
+	{
+		ProjectileManager->ReceiveSpawnEvents(InSpawnEvents);
+	}
+}
+#pragma endregion
@@ -7,16 +7,45 @@
 #include "Characters/Abilities/GRBGameplayAbility.h"
 #include "Characters/Abilities/GRBGATA_LineTrace.h"
 #include "Characters/Abilities/GRBGATA_SphereTrace.h"
+#include "Characters/GRBInventoryComponent.h"
 #include "Characters/Heroes/GRBHeroCharacter.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GRBBlueprintFunctionLibrary.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Net/UnrealNetwork.h"
 #include "Player/GRBPlayerController.h"
+#include "TimerManager.h"
+#include "Weapons/GRBWeaponDefinition.h"
+#include "Weapons/GRBWeaponPickupSubsystem.h"
 
 // 将网络类型转化为字符串
 #define GET_ACTOR_ROLE_FSTRING(Actor) *(FindObject<UEnum>(nullptr, TEXT("/Script/Engine.ENetRole"), true)->GetNameStringByValue(Actor->GetLocalRole()))
 
+static TAutoConsoleVariable<bool> CVarDisableHolsteredWeaponAnimTick(
+	TEXT("GRB.weapon.DisableHolsteredAnimTick"),
+	true,
+	TEXT("Fully disable the skeletal mesh tick of holstered weapons. When false, holstered meshes only fall back to OnlyTickPoseWhenRendered.")
+);
+
+static TAutoConsoleVariable<float> CVarPredictedAmmoGraceSeconds(
+	TEXT("GRB.weapon.PredictedAmmoGraceSeconds"),
+	0.5f,
+	TEXT("Seconds a caught-up predicted ammo spend is kept while waiting for the replicated clip ammo before it is discarded.")
+);
+
+static TAutoConsoleVariable<float> CVarPickupDropperCooldown(
+	TEXT("GRB.pickup.DropperCooldown"),
+	1.5f,
+	TEXT("Seconds after a drop during which the hero who dropped a weapon cannot pick it back up.")
+);
+
+static TAutoConsoleVariable<float> CVarPickupDropDistance(
+	TEXT("GRB.pickup.DropDistance"),
+	150.0f,
+	TEXT("Horizontal distance in front of the dropper at which a dropped weapon lands. Never less than GRB.pickup.Radius plus a small margin.")
+);
+
 AGRBWeapon::AGRBWeapon()
 {
 	// 永不tick
@@ -29,8 +58,9 @@ AGRBWeapon::AGRBWeapon()
 	//关联子对象：对于一些附属于玩家的对象（例如，玩家的武器、装备等），它们的状态和位置只是对拥有该对象的玩家以及其他观测到该玩家行为的玩家相关。在这种情况下，将这些对象的网络相关性设置为依赖于拥有者是很合理的
 	// 意味着武器枪支的网络相关性将依赖于其拥有者，即 PlayerCharacter 对象
 	bNetUseOwnerRelevancy = true;
-	// 网络复制频率
-	NetUpdateFrequency = 100.0f;
+	// 网络复制频率; 武器本身只在弹药/归属变化时才有属性需要同步, 无变化时自适应衰减到下限
+	NetUpdatePolicy = FGRBNetUpdatePolicy(30.0f, 2.0f);
+	NetUpdateFrequency = NetUpdatePolicy.MaxNetUpdateFrequency;
 	// 依据拾取模式设定是否启用碰撞, 枪支作为场景道具时候是拾取碰撞, 作为直接生成物的时候关闭碰撞
 	bSpawnWithCollision = true;
 	// 弹匣载弹相关设置
@@ -46,7 +76,7 @@ AGRBWeapon::AGRBWeapon()
 	CollisionComp = CreateDefaultSubobject<UCapsuleComponent>(FName("CollisionComponent"));
 	CollisionComp->InitCapsuleSize(40.0f, 50.0f);
 	CollisionComp->SetCollisionObjectType(COLLISION_PICKUP);
-	CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision); // Manually enable when in pickup mode
+	CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision); // 拾取由 UGRBWeaponPickupSubsystem 的空间哈希判定, 胶囊体始终不参与碰撞
 	CollisionComp->SetCollisionResponseToAllChannels(ECR_Ignore);
 	CollisionComp->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
 	RootComponent = CollisionComp;
@@ -57,7 +87,7 @@ AGRBWeapon::AGRBWeapon()
 	WeaponMesh1P->CastShadow = false;
 	WeaponMesh1P->SetVisibility(false, true);
 	WeaponMesh1P->SetupAttachment(CollisionComp);
-	WeaponMesh1P->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose; // 用来决定动画组件是否需要在不可见时继续进行动画更新
+	WeaponMesh1P->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered; // 用来决定动画组件是否需要在不可见时继续进行动画更新; 拾取模式下1P不可见, 装备后再切回常驻Tick
 
 	// 处理Mesh3P
 	WeaponMesh3PickupRelativeLocation = FVector(0.0f, -25.0f, 0.0f);
@@ -68,6 +98,7 @@ AGRBWeapon::AGRBWeapon()
 	WeaponMesh3P->CastShadow = true;
 	WeaponMesh3P->SetVisibility(true, true);
 	WeaponMesh3P->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	MeshState = EGRBWeaponMeshState::Pickup;
 
 	// 武器各状态的标签初始化
 	WeaponPrimaryInstantAbilityTag = FGameplayTag::RequestGameplayTag("Ability.Weapon.Primary.Instant");
@@ -75,6 +106,7 @@ AGRBWeapon::AGRBWeapon()
 	WeaponAlternateInstantAbilityTag = FGameplayTag::RequestGameplayTag("Ability.Weapon.Alternate.Instant");
 	WeaponIsFiringTag = FGameplayTag::RequestGameplayTag("Weapon.IsFiring");
 	FireMode = FGameplayTag::RequestGameplayTag("Weapon.FireMode.None");
+	WeaponDefinition = nullptr;
 	StatusText = DefaultStatusText;
 
 	// 保存当异常情况发生会阻碍拾取武器的标签组
@@ -82,22 +114,40 @@ AGRBWeapon::AGRBWeapon()
 	RestrictedPickupTags.AddTag(FGameplayTag::RequestGameplayTag("State.KnockedDown"));
 }
 
+void AGRBWeapon::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// 以编辑期配置的初始载弹量作为运行时载弹量; 各端一致, 持有者随后以服务端同步为准
+	ClipAmmo.PrimaryClipAmmo = PrimaryClipAmmo;
+	ClipAmmo.MaxPrimaryClipAmmo = MaxPrimaryClipAmmo;
+	ClipAmmo.SecondaryClipAmmo = SecondaryClipAmmo;
+	ClipAmmo.MaxSecondaryClipAmmo = MaxSecondaryClipAmmo;
+}
+
 void AGRBWeapon::BeginPlay()
 {
 	// 复位武器开火模式Tag
 	ResetWeapon();
 
-	// 没有宿主且允许拾取 则给到一个默认碰撞
-	// Spawned into the world without an owner, enable collision as we are in pickup mode
-	if (!OwningCharacter && bSpawnWithCollision)
+	Super::BeginPlay();
+
+	// 没有宿主且处于拾取模式: 登记进拾取管理器, 不再开启拾取胶囊体
+	// Spawned into the world without an owner, register as a pickup
+	if (HasAuthority() && !OwningCharacter && bSpawnWithCollision)
 	{
-		CollisionComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		SetRegisteredAsPickup(true);
 	}
-	Super::BeginPlay();
+
+	NetUpdatePolicy.ApplyTo(this);
+	// 无主的武器静置在场景里, 没有需要同步的变化, 直接休眠
+	RefreshNetDormancy();
 }
 
 void AGRBWeapon::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
+	SetRegisteredAsPickup(false);
+
 	if (LineTraceTargetActor)
 	{
 		LineTraceTargetActor->Destroy();
@@ -113,6 +163,13 @@ void AGRBWeapon::EndPlay(EEndPlayReason::Type EndPlayReason)
 void AGRBWeapon::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// 载弹量只有持有者关心; 推送模型下只在服务端真正改值时才参与比较
+	FDoRepLifetimeParams ClipAmmoParams;
+	ClipAmmoParams.Condition = COND_OwnerOnly;
+	ClipAmmoParams.RepNotifyCondition = REPNOTIFY_Always;
+	ClipAmmoParams.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AGRBWeapon, ClipAmmo, ClipAmmoParams);
 }
 
 void AGRBWeapon::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
@@ -120,11 +177,49 @@ void AGRBWeapon::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTrack
 	Super::PreReplication(ChangedPropertyTracker);
 }
 
+float AGRBWeapon::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	const float BasePriority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+	return NetUpdatePolicy.ScaleNetPriority(BasePriority, this, ViewPos, ViewDir, Viewer, ViewTarget);
+}
+
 void AGRBWeapon::NotifyActorBeginOverlap(AActor* Other)
 {
 	Super::NotifyActorBeginOverlap(Other);
 }
 
+///--@brief 英雄进入拾取范围; 由拾取管理器在服务端调用--/
+void AGRBWeapon::OnPickupProximity(AGRBHeroCharacter* InCharacter)
+{
+	if (!HasAuthority() || !IsValid(InCharacter) || OwningCharacter)
+	{
+		return;
+	}
+
+	// 落点被墙挡回时可能仍在丢弃者的拾取范围内, 冷却内不拾回
+	if (LastDroppedBy.Get() == InCharacter && GetWorld()->GetTimeSeconds() - LastDropTime < CVarPickupDropperCooldown.GetValueOnGameThread())
+	{
+		return;
+	}
+	PickUpOnTouch(InCharacter);
+}
+
+void AGRBWeapon::PickUpOnTouch(AGRBHeroCharacter* InCharacter)
+{
+	// 死亡/倒地等状态下不可拾取
+	UAbilitySystemComponent* const CharacterASC = InCharacter->GetAbilitySystemComponent();
+	if (!InCharacter->IsAlive() || (CharacterASC && CharacterASC->HasAnyMatchingGameplayTags(RestrictedPickupTags)))
+	{
+		return;
+	}
+
+	// 入包即挂接并从拾取管理器注销
+	if (UGRBInventoryComponent* const Inventory = InCharacter->GetInventoryComponent())
+	{
+		Inventory->AddWeapon(this);
+	}
+}
+
 UAbilitySystemComponent* AGRBWeapon::GetAbilitySystemComponent() const
 {
 	return nullptr;
@@ -140,6 +235,210 @@ USkeletalMeshComponent* AGRBWeapon::GetWeaponMesh3P() const
 	return WeaponMesh3P;
 }
 
+int32 AGRBWeapon::GetPrimaryClipAmmo() const
+{
+	// 本地预测端: 同步值减去尚未被覆盖的预测扣弹
+	return FMath::Max(ClipAmmo.PrimaryClipAmmo - PredictedPrimaryAmmoSpent, 0);
+}
+
+int32 AGRBWeapon::GetMaxPrimaryClipAmmo() const
+{
+	return ClipAmmo.MaxPrimaryClipAmmo;
+}
+
+int32 AGRBWeapon::GetSecondaryClipAmmo() const
+{
+	return ClipAmmo.SecondaryClipAmmo;
+}
+
+int32 AGRBWeapon::GetMaxSecondaryClipAmmo() const
+{
+	return ClipAmmo.MaxSecondaryClipAmmo;
+}
+
+void AGRBWeapon::SetPrimaryClipAmmo(int32 NewPrimaryClipAmmo)
+{
+	UpdateClipAmmo(&FGRBWeaponClipAmmo::PrimaryClipAmmo, NewPrimaryClipAmmo, OnPrimaryClipAmmoChanged);
+}
+
+void AGRBWeapon::SetMaxPrimaryClipAmmo(int32 NewMaxPrimaryClipAmmo)
+{
+	UpdateClipAmmo(&FGRBWeaponClipAmmo::MaxPrimaryClipAmmo, NewMaxPrimaryClipAmmo, OnMaxPrimaryClipAmmoChanged);
+}
+
+void AGRBWeapon::SetSecondaryClipAmmo(int32 NewSecondaryClipAmmo)
+{
+	UpdateClipAmmo(&FGRBWeaponClipAmmo::SecondaryClipAmmo, NewSecondaryClipAmmo, OnSecondaryClipAmmoChanged);
+}
+
+void AGRBWeapon::SetMaxSecondaryClipAmmo(int32 NewMaxSecondaryClipAmmo)
+{
+	UpdateClipAmmo(&FGRBWeaponClipAmmo::MaxSecondaryClipAmmo, NewMaxSecondaryClipAmmo, OnMaxSecondaryClipAmmoChanged);
+}
+
+///--@brief 改写单项载弹量; 服务端标记推送脏, 本地预测端只改本地值--/
+void AGRBWeapon::UpdateClipAmmo(int32 FGRBWeaponClipAmmo::* InField, int32 InNewValue, FWeaponAmmoChangedDelegate& InChangedDelegate)
+{
+	const int32 OldValue = ClipAmmo.*InField;
+	if (OldValue == InNewValue)
+	{
+		return;
+	}
+
+	ClipAmmo.*InField = InNewValue;
+	if (HasAuthority())
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AGRBWeapon, ClipAmmo, this);
+		// 休眠中(收起/掉落)的武器改了载弹量: 只冲刷一次把新值送出去, 不解除休眠
+		if (NetDormancy > DORM_Awake)
+		{
+			FlushNetDormancy();
+		}
+	}
+	InChangedDelegate.Broadcast(OldValue, InNewValue);
+}
+
+///--@brief 扣除主弹匣载弹量; 本地预测端按预测Key记账并在Key被拒绝时回滚, 服务端直接扣除--/
+void AGRBWeapon::SpendPrimaryClipAmmo(int32 InAmount, const FPredictionKey& InPredictionKey)
+{
+	if (InAmount <= 0)
+	{
+		return;
+	}
+
+	// 服务端/无预测窗口: 直接改权威值
+	if (HasAuthority() || !InPredictionKey.IsLocalClientKey())
+	{
+		SetPrimaryClipAmmo(ClipAmmo.PrimaryClipAmmo - InAmount);
+		return;
+	}
+
+	const int32 OldPrimaryClipAmmo = GetPrimaryClipAmmo();
+	const FPredictionKey::KeyType KeyId = InPredictionKey.Current;
+	const bool bKeyAlreadyBound = PredictedAmmoSpends.ContainsByPredicate([KeyId](const FPredictedAmmoSpend& Spend) { return Spend.Key == KeyId; });
+
+	FPredictedAmmoSpend& Spend = PredictedAmmoSpends.AddDefaulted_GetRef();
+	Spend.Key = KeyId;
+	Spend.Amount = InAmount;
+	PredictedPrimaryAmmoSpent += InAmount;
+	Spend.BaseClipAmmo = ClipAmmo.PrimaryClipAmmo;
+	Spend.ExpectedClipAmmo = ClipAmmo.PrimaryClipAmmo - PredictedPrimaryAmmoSpent;
+
+	// 同一预测窗口内的多发共用一组回调
+	if (!bKeyAlreadyBound)
+	{
+		FPredictionKey MutableKey = InPredictionKey;
+		MutableKey.NewRejectedDelegate().BindUObject(this, &AGRBWeapon::OnPredictedAmmoSpendResolved, KeyId, true);
+		MutableKey.NewCaughtUpDelegate().BindUObject(this, &AGRBWeapon::OnPredictedAmmoSpendResolved, KeyId, false);
+	}
+	NotifyPrimaryClipAmmoChanged(OldPrimaryClipAmmo);
+}
+
+///--@brief 预测扣弹的Key被服务端确认或拒绝--/
+void AGRBWeapon::OnPredictedAmmoSpendResolved(FPredictionKey::KeyType InKey, bool bRejected)
+{
+	const int32 OldPrimaryClipAmmo = GetPrimaryClipAmmo();
+	bool bAnyCaughtUp = false;
+	for (int32 Index = PredictedAmmoSpends.Num() - 1; Index >= 0; --Index)
+	{
+		FPredictedAmmoSpend& Spend = PredictedAmmoSpends[Index];
+		if (Spend.Key != InKey)
+		{
+			continue;
+		}
+
+		if (bRejected)
+		{
+			// 服务端没有扣这笔弹药, 立即回滚
+			PredictedPrimaryAmmoSpent -= Spend.Amount;
+			PredictedAmmoSpends.RemoveAt(Index, 1, false);
+		}
+		else
+		{
+			// 服务端已扣除; 权威载弹量与Key确认分属不同Actor同步, 先标记, 等载弹量到达再丢弃, 免得数值先回弹
+			Spend.bCaughtUp = true;
+			bAnyCaughtUp = true;
+		}
+	}
+
+	if (bAnyCaughtUp)
+	{
+		GetWorldTimerManager().SetTimer(CaughtUpAmmoSpendTimerHandle, this, &AGRBWeapon::DiscardCaughtUpAmmoSpends, FMath::Max(CVarPredictedAmmoGraceSeconds.GetValueOnGameThread(), 0.01f), false);
+	}
+	NotifyPrimaryClipAmmoChanged(OldPrimaryClipAmmo);
+}
+
+///--@brief 丢弃已被服务端确认的预测扣弹; 之后以同步回来的载弹量为准--/
+void AGRBWeapon::DiscardCaughtUpAmmoSpends()
+{
+	const int32 OldPrimaryClipAmmo = GetPrimaryClipAmmo();
+	for (int32 Index = PredictedAmmoSpends.Num() - 1; Index >= 0; --Index)
+	{
+		if (PredictedAmmoSpends[Index].bCaughtUp)
+		{
+			PredictedPrimaryAmmoSpent -= PredictedAmmoSpends[Index].Amount;
+			PredictedAmmoSpends.RemoveAt(Index, 1, false);
+		}
+	}
+	NotifyPrimaryClipAmmoChanged(OldPrimaryClipAmmo);
+}
+
+///--@brief 同步回来的权威载弹量是否已体现这笔预测扣弹--/
+bool AGRBWeapon::IsAmmoSpendReflected(const FPredictedAmmoSpend& InSpend) const
+{
+	// 降到预期值: 服务端已扣过这一笔; 比预测基准还高: 服务端换弹/补弹覆盖了这笔预测
+	return ClipAmmo.PrimaryClipAmmo <= InSpend.ExpectedClipAmmo || ClipAmmo.PrimaryClipAmmo > InSpend.BaseClipAmmo;
+}
+
+///--@brief 主弹匣预测值变化时广播--/
+void AGRBWeapon::NotifyPrimaryClipAmmoChanged(int32 InOldPrimaryClipAmmo)
+{
+	const int32 NewPrimaryClipAmmo = GetPrimaryClipAmmo();
+	if (InOldPrimaryClipAmmo != NewPrimaryClipAmmo)
+	{
+		OnPrimaryClipAmmoChanged.Broadcast(InOldPrimaryClipAmmo, NewPrimaryClipAmmo);
+	}
+}
+
+///--@brief 打包载弹量同步回来; 逐项与本地值比较并广播变化--/
+void AGRBWeapon::OnRep_ClipAmmo(const FGRBWeaponClipAmmo& OldClipAmmo)
+{
+	// 主弹匣按预测值比较; 已确认或已被权威值体现的预测扣弹此时丢弃
+	// (载弹量可能先于Key确认同步回来, 只等Key会在这段时间里重复扣减)
+	const int32 OldPrimaryClipAmmo = FMath::Max(OldClipAmmo.PrimaryClipAmmo - PredictedPrimaryAmmoSpent, 0);
+	if (PredictedAmmoSpends.Num() > 0)
+	{
+		GetWorldTimerManager().ClearTimer(CaughtUpAmmoSpendTimerHandle);
+		PredictedAmmoSpends.RemoveAllSwap([this](const FPredictedAmmoSpend& Spend)
+		{
+			if (Spend.bCaughtUp || IsAmmoSpendReflected(Spend))
+			{
+				PredictedPrimaryAmmoSpent -= Spend.Amount;
+				return true;
+			}
+			return false;
+		}, false);
+	}
+	NotifyPrimaryClipAmmoChanged(OldPrimaryClipAmmo);
+	if (OldClipAmmo.MaxPrimaryClipAmmo != ClipAmmo.MaxPrimaryClipAmmo)
+	{
+		OnMaxPrimaryClipAmmoChanged.Broadcast(OldClipAmmo.MaxPrimaryClipAmmo, ClipAmmo.MaxPrimaryClipAmmo);
+	}
+	if (OldClipAmmo.SecondaryClipAmmo != ClipAmmo.SecondaryClipAmmo)
+	{
+		OnSecondaryClipAmmoChanged.Broadcast(OldClipAmmo.SecondaryClipAmmo, ClipAmmo.SecondaryClipAmmo);
+	}
+	if (OldClipAmmo.MaxSecondaryClipAmmo != ClipAmmo.MaxSecondaryClipAmmo)
+	{
+		OnMaxSecondaryClipAmmoChanged.Broadcast(OldClipAmmo.MaxSecondaryClipAmmo, ClipAmmo.MaxSecondaryClipAmmo);
+	}
+}
+
+const FGRBWeaponFireParams* AGRBWeapon::GetFireParams() const
+{
+	return WeaponDefinition ? &WeaponDefinition->GetFireParams() : nullptr;
+}
+
 void AGRBWeapon::AddAbilities()
 {
 	// 确保枪有装备了ASC的枪手
@@ -201,27 +500,196 @@ void AGRBWeapon::RemoveAbilities()
 
 void AGRBWeapon::SetOwningCharacter(AGRBHeroCharacter* InOwningCharacter)
 {
+	AGRBHeroCharacter* const PreviousOwningCharacter = OwningCharacter;
 	OwningCharacter = InOwningCharacter;
 	if (OwningCharacter)
 	{
+		// 被拾取后唤醒, 让新的归属与挂接状态同步出去; 收起后再按枪皮状态回到休眠
+		if (HasAuthority())
+		{
+			SetNetDormancy(DORM_Awake);
+		}
+
 		// Called when added to inventory
 		AbilitySystemComponent = Cast<UGRBAbilitySystemComponent>(OwningCharacter->GetAbilitySystemComponent());
 		SetOwner(InOwningCharacter);
 		AttachToComponent(OwningCharacter->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-		CollisionComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		SetRegisteredAsPickup(false);
 
-		// 已装备其他枪支的情形;
+		// 已装备其他枪支的情形: 直接收起; 装备时由背包组件翻转为装备状态
 		if (OwningCharacter->GetCurrentWeapon() != this)
 		{
-			WeaponMesh3P->CastShadow = false;
-			WeaponMesh3P->SetVisibility(true, true);
-			WeaponMesh3P->SetVisibility(false, true);
+			SetMeshState(EGRBWeaponMeshState::Holstered);
 		}
 	}
 	else
 	{
+		SetMeshState(EGRBWeaponMeshState::Pickup);
 		AbilitySystemComponent = nullptr;
 		SetOwner(nullptr);
 		DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		// 换手后旧持有者的预测扣弹不再有意义
+		PredictedAmmoSpends.Reset();
+		PredictedPrimaryAmmoSpent = 0;
+		GetWorldTimerManager().ClearTimer(CaughtUpAmmoSpendTimerHandle);
+
+		// 掉落: 记下丢弃者, 再由 OnDropped 确定落点后登记为可拾取; 广播前先唤醒, 否则休眠中的武器收不到这次广播
+		if (HasAuthority())
+		{
+			LastDroppedBy = PreviousOwningCharacter;
+			LastDropTime = GetWorld()->GetTimeSeconds();
+			SetNetDormancy(DORM_Awake);
+			OnDropped(ComputeDropLocation(PreviousOwningCharacter));
+		}
+
+		// 脱离宿主后进入休眠; 休眠前的最后一次变化仍会先同步出去
+		RefreshNetDormancy();
+	}
+}
+
+void AGRBWeapon::SetMeshState(EGRBWeaponMeshState InMeshState)
+{
+	if (MeshState == InMeshState)
+	{
+		return;
+	}
+	MeshState = InMeshState;
+
+	const bool bHolstered = InMeshState == EGRBWeaponMeshState::Holstered;
+	const bool bVisible1P = InMeshState == EGRBWeaponMeshState::Equipped1P;
+	const bool bVisible3P = InMeshState == EGRBWeaponMeshState::Pickup || InMeshState == EGRBWeaponMeshState::Equipped3P;
+	// 收起的武器没有任何需要求值的姿势; 关闭开关时至少降为仅渲染时Tick
+	const bool bTickEnabled = !bHolstered || !CVarDisableHolsteredWeaponAnimTick.GetValueOnGameThread();
+
+	WeaponMesh1P->SetVisibility(bVisible1P, true);
+	WeaponMesh1P->VisibilityBasedAnimTickOption = bVisible1P ? EVisibilityBasedAnimTickOption::AlwaysTickPose : EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	WeaponMesh1P->SetComponentTickEnabled(bTickEnabled);
+
+	// 第一视角装备时3P枪皮隐藏但仍投射阴影, 取代原先先显示再隐藏的写法
+	WeaponMesh3P->SetVisibility(bVisible3P, true);
+	WeaponMesh3P->SetCastShadow(!bHolstered);
+	WeaponMesh3P->SetCastHiddenShadow(InMeshState == EGRBWeaponMeshState::Equipped1P);
+	WeaponMesh3P->VisibilityBasedAnimTickOption = bHolstered ? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPose;
+	WeaponMesh3P->SetComponentTickEnabled(bTickEnabled);
+
+	// 收起即休眠, 装备即唤醒
+	RefreshNetDormancy();
+}
+
+void AGRBWeapon::OnDropped_Implementation(FVector NewLocation)
+{
+	// 各端落到最终位置; 服务端此后才登记为可拾取, 之后再被移动会随之重新入格
+	SetActorLocation(NewLocation, false, nullptr, ETeleportType::TeleportPhysics);
+	if (HasAuthority() && !OwningCharacter)
+	{
+		SetRegisteredAsPickup(true);
+	}
+}
+
+bool AGRBWeapon::OnDropped_Validate(FVector NewLocation)
+{
+	return true;
+}
+
+///--@brief 服务端: 丢弃者前方拾取范围之外的落地点; 前方被挡则退到挡住处, 向下贴地--/
+FVector AGRBWeapon::ComputeDropLocation(const AGRBHeroCharacter* InDropper) const
+{
+	UWorld* const World = GetWorld();
+	if (!World || !IsValid(InDropper))
+	{
+		return GetActorLocation();
+	}
+
+	const UCapsuleComponent* const Capsule = InDropper->GetCapsuleComponent();
+	const float CapsuleRadius = Capsule ? Capsule->GetScaledCapsuleRadius() : 0.0f;
+	const float CapsuleHalfHeight = Capsule ? Capsule->GetScaledCapsuleHalfHeight() : 0.0f;
+	const FVector DropperLocation = InDropper->GetActorLocation();
+	const FVector Forward = FRotator(0.0f, InDropper->GetActorRotation().Yaw, 0.0f).Vector();
+	// 至少落在拾取范围之外, 冷却结束后原地不动也不会被立即拾回
+	const float DropDistance = FMath::Max(CVarPickupDropDistance.GetValueOnGameThread(), UGRBWeaponPickupSubsystem::GetPickupRadius() + CapsuleRadius);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GRBWeaponDrop), false);
+	QueryParams.AddIgnoredActor(InDropper);
+	QueryParams.AddIgnoredActor(this);
+
+	// 前方被墙挡住时退到墙前, 不把武器丢进墙里
+	FVector DropLocation = DropperLocation + Forward * DropDistance;
+	FHitResult Hit;
+	if (World->LineTraceSingleByChannel(Hit, DropperLocation, DropLocation, ECC_Visibility, QueryParams))
+	{
+		DropLocation = Hit.Location - Forward * CapsuleRadius;
+	}
+
+	// 向下贴地, 与丢弃者一样离地半个胶囊体高
+	if (World->LineTraceSingleByChannel(Hit, DropLocation, DropLocation - FVector(0.0f, 0.0f, CapsuleHalfHeight * 4.0f), ECC_Visibility, QueryParams))
+	{
+		DropLocation = Hit.Location + FVector(0.0f, 0.0f, CapsuleHalfHeight);
+	}
+	return DropLocation;
+}
+
+///--@brief 服务端: 登记/注销为可拾取; 登记期间随根组件移动重新入格--/
+void AGRBWeapon::SetRegisteredAsPickup(bool bInRegistered)
+{
+	UWorld* const World = GetWorld();
+	UGRBWeaponPickupSubsystem* const PickupSubsystem = World ? World->GetSubsystem<UGRBWeaponPickupSubsystem>() : nullptr;
+	USceneComponent* const Root = GetRootComponent();
+	if (bInRegistered)
+	{
+		if (!HasAuthority() || !PickupSubsystem)
+		{
+			return;
+		}
+		PickupSubsystem->RegisterPickup(this);
+		if (Root && !PickupTransformUpdatedHandle.IsValid())
+		{
+			PickupTransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &AGRBWeapon::OnPickupTransformUpdated);
+		}
+	}
+	else
+	{
+		if (PickupSubsystem)
+		{
+			PickupSubsystem->UnregisterPickup(this);
+		}
+		if (Root && PickupTransformUpdatedHandle.IsValid())
+		{
+			Root->TransformUpdated.Remove(PickupTransformUpdatedHandle);
+		}
+		PickupTransformUpdatedHandle.Reset();
+	}
+}
+
+///--@brief 登记为可拾取期间根组件移动: 按新位置重新入格--/
+void AGRBWeapon::OnPickupTransformUpdated(USceneComponent* InUpdatedComponent, EUpdateTransformFlags InUpdateTransformFlags, ETeleportType InTeleport)
+{
+	// 格子未变时 RegisterPickup 直接返回
+	if (UGRBWeaponPickupSubsystem* const PickupSubsystem = GetWorld()->GetSubsystem<UGRBWeaponPickupSubsystem>())
+	{
+		PickupSubsystem->RegisterPickup(this);
+	}
+}
+
+///--@brief 按归属与枪皮状态切换网络休眠; 仅服务端--/
+void AGRBWeapon::RefreshNetDormancy()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// 掉落在地或收在背包里的武器没有需要逐帧考虑的同步; 仅装备中的武器保持唤醒
+	const bool bDormant = !OwningCharacter || MeshState == EGRBWeaponMeshState::Holstered;
+	const ENetDormancy DesiredDormancy = bDormant ? DORM_DormantAll : DORM_Awake;
+	if (NetDormancy == DesiredDormancy)
+	{
+		return;
+	}
+
+	SetNetDormancy(DesiredDormancy);
+	if (bDormant)
+	{
+		// 拾取入包时同一帧内先唤醒再收起; 冲刷一次, 保证刚改的归属/挂接状态仍会同步出去
+		FlushNetDormancy();
 	}
 }
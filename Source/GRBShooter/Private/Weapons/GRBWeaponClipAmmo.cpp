@@ -0,0 +1,54 @@
+// Copyright 2024 GRB.
+
+
+#include "Weapons/GRBWeaponClipAmmo.h"
+
+namespace GRBWeaponClipAmmo
+{
+	// 单项载弹量的量化上限
+	constexpr int32 MaxQuantizedAmmo = MAX_uint16;
+
+	///--@brief 序列化单项载弹量: 掩码位为0的项不占字节--/
+	static void SerializeAmmo(FArchive& Ar, int32& InOutAmmo, uint8 InMask, uint8 InBit)
+	{
+		if (!(InMask & InBit))
+		{
+			InOutAmmo = 0;
+			return;
+		}
+
+		uint32 Quantized = static_cast<uint32>(FMath::Clamp(InOutAmmo, 0, MaxQuantizedAmmo));
+		Ar.SerializeIntPacked(Quantized);
+		InOutAmmo = static_cast<int32>(FMath::Min<uint32>(Quantized, MaxQuantizedAmmo));
+	}
+}
+
+///--@brief 量化并打包序列化--/
+bool FGRBWeaponClipAmmo::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	enum : uint8
+	{
+		Bit_Primary = 1 << 0,
+		Bit_MaxPrimary = 1 << 1,
+		Bit_Secondary = 1 << 2,
+		Bit_MaxSecondary = 1 << 3,
+	};
+
+	uint8 Mask = 0;
+	if (Ar.IsSaving())
+	{
+		Mask |= PrimaryClipAmmo > 0 ? Bit_Primary : 0;
+		Mask |= MaxPrimaryClipAmmo > 0 ? Bit_MaxPrimary : 0;
+		Mask |= SecondaryClipAmmo > 0 ? Bit_Secondary : 0;
+		Mask |= MaxSecondaryClipAmmo > 0 ? Bit_MaxSecondary : 0;
+	}
+	Ar.SerializeBits(&Mask, 4);
+
+	GRBWeaponClipAmmo::SerializeAmmo(Ar, PrimaryClipAmmo, Mask, Bit_Primary);
+	GRBWeaponClipAmmo::SerializeAmmo(Ar, MaxPrimaryClipAmmo, Mask, Bit_MaxPrimary);
+	GRBWeaponClipAmmo::SerializeAmmo(Ar, SecondaryClipAmmo, Mask, Bit_Secondary);
+	GRBWeaponClipAmmo::SerializeAmmo(Ar, MaxSecondaryClipAmmo, Mask, Bit_MaxSecondary);
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
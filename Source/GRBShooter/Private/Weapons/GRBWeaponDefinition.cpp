@@ -0,0 +1,118 @@
+// Copyright 2024 GRB.
+
+
+#include "Weapons/GRBWeaponDefinition.h"
+#include "Characters/Abilities/GRBGATA_LineTrace.h"
+#include "Characters/Abilities/GRBGATA_SphereTrace.h"
+#include "Components/MeshComponent.h"
+
+#pragma region ~ 探查器参数 ~
+///--@brief 一次性写入射线探查器的全部配置; 返回探查器的配置版本号--/
+uint32 FGRBWeaponTraceParams::ConfigureLineTrace(AGRBGATA_LineTrace* InTraceActor, const FGameplayAbilityTargetingLocationInfo& InStartLocation) const
+{
+	if (!IsValid(InTraceActor))
+	{
+		return 0;
+	}
+	InTraceActor->Configure(InStartLocation, AimingTag, AimingRemovalTag, TraceProfile, FGameplayTargetDataFilterHandle(), ReticleClass,
+	                        FWorldReticleParameters(), bIgnoreBlockingHits, false,
+	                        bUsePersistentHitResults, false, bTraceAffectsAimPitch,
+	                        bTraceFromPlayerViewPoint, bUseAimingSpreadMod, MaxRange,
+	                        BaseSpread, AimingSpreadMod, TargetingSpreadIncrement,
+	                        TargetingSpreadMax, MaxHitResultsPerTrace, NumberOfTraces
+	);
+	return InTraceActor->GetConfigVersion();
+}
+
+///--@brief 一次性写入球型探查器的全部配置; 返回探查器的配置版本号--/
+uint32 FGRBWeaponTraceParams::ConfigureSphereTrace(AGRBGATA_SphereTrace* InTraceActor, const FGameplayAbilityTargetingLocationInfo& InStartLocation) const
+{
+	if (!IsValid(InTraceActor))
+	{
+		return 0;
+	}
+	InTraceActor->Configure(InStartLocation, AimingTag, AimingRemovalTag, TraceProfile, FGameplayTargetDataFilterHandle(), ReticleClass,
+	                        FWorldReticleParameters(), bIgnoreBlockingHits, false,
+	                        bUsePersistentHitResults, false, bTraceAffectsAimPitch,
+	                        bTraceFromPlayerViewPoint, bUseAimingSpreadMod, MaxRange,
+	                        TraceSphereRadius, BaseSpread, AimingSpreadMod, TargetingSpreadIncrement,
+	                        TargetingSpreadMax, MaxHitResultsPerTrace, NumberOfTraces
+	);
+	return InTraceActor->GetConfigVersion();
+}
+
+///--@brief 构建以枪口插槽为起点的目标位置信息--/
+FGameplayAbilityTargetingLocationInfo FGRBWeaponTraceParams::MakeMuzzleLocation(UMeshComponent* InWeaponMesh) const
+{
+	FGameplayAbilityTargetingLocationInfo LocationInfo;
+	LocationInfo.LocationType = EGameplayAbilityTargetingLocationType::SocketTransform;
+	LocationInfo.LiteralTransform = FTransform();
+	LocationInfo.SourceActor = nullptr;
+	LocationInfo.SourceComponent = InWeaponMesh;
+	LocationInfo.SourceAbility = nullptr;
+	LocationInfo.SourceSocketName = MuzzleSocketName;
+	return LocationInfo;
+}
+#pragma endregion
+
+
+#pragma region ~ 武器定义 ~
+void UGRBWeaponDefinition::PostLoad()
+{
+	Super::PostLoad();
+	BakeFireParams();
+}
+
+FPrimaryAssetId UGRBWeaponDefinition::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(FPrimaryAssetType(TEXT("GRBWeaponDefinition")), GetFName());
+}
+
+#if WITH_EDITOR
+void UGRBWeaponDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	BakeFireParams();
+}
+#endif
+
+///--@brief 把编辑期参数规整为运行时参数包--/
+void UGRBWeaponDefinition::BakeFireParams()
+{
+	FireParams.PrimaryTrace = BakeTraceParams(PrimaryTrace);
+	FireParams.SecondaryTrace = BakeTraceParams(SecondaryTrace);
+	FireParams.DamageEffectClass = DamageEffectClass;
+	FireParams.FireMontage = FireMontage;
+	FireParams.AimFireMontage = AimFireMontage ? AimFireMontage : FireMontage;
+	FireParams.FireCueTag = FireCueTag;
+	FireParams.Damage = Damage;
+	FireParams.TimeBetweenShots = 60.0f / FMath::Max(RoundsPerMinute, 1.0f);
+	FireParams.AmmoCost = FMath::Max(AmmoCost, 0);
+}
+
+///--@brief 规整单个探查器参数--/
+FGRBWeaponTraceParams UGRBWeaponDefinition::BakeTraceParams(const FGRBWeaponTraceParams& InTraceParams)
+{
+	FGRBWeaponTraceParams Baked = InTraceParams;
+	Baked.MaxRange = FMath::Max(Baked.MaxRange, 0.0f);
+	Baked.TraceSphereRadius = FMath::Max(Baked.TraceSphereRadius, 0.0f);
+	Baked.BaseSpread = FMath::Max(Baked.BaseSpread, 0.0f);
+	Baked.TargetingSpreadIncrement = FMath::Max(Baked.TargetingSpreadIncrement, 0.0f);
+	Baked.TargetingSpreadMax = FMath::Max(Baked.TargetingSpreadMax, 0.0f);
+	Baked.NumberOfTraces = FMath::Max(Baked.NumberOfTraces, 1);
+
+	// 瞄准调幅必须成对配置瞄准Tag, 缺一个就整体关掉, 免得探查器每帧去查无效Tag
+	Baked.bUseAimingSpreadMod = Baked.bUseAimingSpreadMod && Baked.AimingTag.IsValid() && Baked.AimingRemovalTag.IsValid();
+	if (!Baked.bUseAimingSpreadMod)
+	{
+		Baked.AimingSpreadMod = 0.0f;
+	}
+
+	// 持续命中模式下探查器只支持单次Trace
+	if (Baked.bUsePersistentHitResults)
+	{
+		Baked.NumberOfTraces = 1;
+	}
+	return Baked;
+}
+#pragma endregion
@@ -0,0 +1,171 @@
+// Copyright 2024 GRB.
+
+
+#include "Weapons/GRBWeaponPickupSubsystem.h"
+#include "Characters/Heroes/GRBHeroCharacter.h"
+#include "Engine/World.h"
+#include "Weapons/GRBWeapon.h"
+
+DECLARE_CYCLE_STAT(TEXT("PickupSubsystem Tick"), STAT_GRBPickup_Tick, STATGROUP_GRBPickup);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Pickups"), STAT_GRBPickup_NumPickups, STATGROUP_GRBPickup);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawns Checked"), STAT_GRBPickup_PawnsChecked, STATGROUP_GRBPickup);
+
+static TAutoConsoleVariable<float> CVarPickupCellSize(
+	TEXT("GRB.pickup.CellSize"),
+	200.0f,
+	TEXT("Edge length of the uniform spatial hash cells used for weapon pickups. Applied when the hash is empty.")
+);
+
+static TAutoConsoleVariable<float> CVarPickupRadius(
+	TEXT("GRB.pickup.Radius"),
+	90.0f,
+	TEXT("Distance from a hero's location within which a dropped weapon is picked up")
+);
+
+#pragma region ~ UGRBWeaponPickupSubsystem ~
+bool UGRBWeaponPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGRBWeaponPickupSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_GRBPickup_NumPickups, PickupCells.Num());
+	Grid.Reset();
+	PickupCells.Empty();
+	TrackedPawns.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UGRBWeaponPickupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGRBWeaponPickupSubsystem, STATGROUP_Tickables);
+}
+
+void UGRBWeaponPickupSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GRBPickup_Tick);
+
+	if (PickupCells.Num() == 0)
+	{
+		bPickupsAddedSinceLastTick = false;
+		return;
+	}
+
+	// 有新武器入表时, 静止的英雄也要查一次
+	const bool bCheckAll = bPickupsAddedSinceLastTick;
+	bPickupsAddedSinceLastTick = false;
+
+	for (int32 Index = TrackedPawns.Num() - 1; Index >= 0; --Index)
+	{
+		FTrackedPawn& Tracked = TrackedPawns[Index];
+		AGRBHeroCharacter* const Hero = Tracked.Hero.Get();
+		if (!IsValid(Hero))
+		{
+			TrackedPawns.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		const FVector Location = Hero->GetActorLocation();
+		const bool bMoved = !Tracked.bEverChecked || FVector::DistSquared(Location, Tracked.LastCheckedLocation) > 1.0f;
+		if (!bMoved && !bCheckAll)
+		{
+			continue;
+		}
+
+		Tracked.LastCheckedLocation = Location;
+		Tracked.bEverChecked = true;
+		INC_DWORD_STAT(STAT_GRBPickup_PawnsChecked);
+		CheckPickupsAround(Hero, Location);
+	}
+}
+
+///--@brief 登记一把可拾取的武器; 已登记时按当前位置重新入格--/
+void UGRBWeaponPickupSubsystem::RegisterPickup(AGRBWeapon* InWeapon)
+{
+	if (!IsValid(InWeapon))
+	{
+		return;
+	}
+
+	Grid.SetCellSizeIfEmpty(FMath::Max(CVarPickupCellSize.GetValueOnGameThread(), 10.0f));
+
+	const FIntVector Cell = Grid.GetCellCoord(InWeapon->GetActorLocation());
+	const FPickupGrid::FCellRange NewCell{Cell, Cell};
+	if (FPickupGrid::FCellRange* const ExistingCell = PickupCells.Find(InWeapon))
+	{
+		if (*ExistingCell == NewCell)
+		{
+			return;
+		}
+		Grid.Remove(*ExistingCell, InWeapon);
+		*ExistingCell = NewCell;
+	}
+	else
+	{
+		PickupCells.Add(InWeapon, NewCell);
+		INC_DWORD_STAT(STAT_GRBPickup_NumPickups);
+	}
+
+	Grid.Add(NewCell, InWeapon);
+	bPickupsAddedSinceLastTick = true;
+}
+
+///--@brief 注销可拾取的武器(被拾取/销毁)--/
+void UGRBWeaponPickupSubsystem::UnregisterPickup(AGRBWeapon* InWeapon)
+{
+	FPickupGrid::FCellRange Cell;
+	if (PickupCells.RemoveAndCopyValue(InWeapon, Cell))
+	{
+		Grid.Remove(Cell, InWeapon);
+		DEC_DWORD_STAT(STAT_GRBPickup_NumPickups);
+	}
+}
+
+///--@brief 登记参与拾取检查的英雄--/
+void UGRBWeaponPickupSubsystem::RegisterPawn(AGRBHeroCharacter* InHero)
+{
+	if (!IsValid(InHero) || TrackedPawns.ContainsByPredicate([InHero](const FTrackedPawn& Tracked) { return Tracked.Hero == InHero; }))
+	{
+		return;
+	}
+
+	FTrackedPawn& Tracked = TrackedPawns.AddDefaulted_GetRef();
+	Tracked.Hero = InHero;
+}
+
+///--@brief 注销参与拾取检查的英雄--/
+void UGRBWeaponPickupSubsystem::UnregisterPawn(AGRBHeroCharacter* InHero)
+{
+	TrackedPawns.RemoveAllSwap([InHero](const FTrackedPawn& Tracked) { return !Tracked.Hero.IsValid() || Tracked.Hero == InHero; }, false);
+}
+
+///--@brief 英雄位置与武器的拾取距离(GRB.pickup.Radius)--/
+float UGRBWeaponPickupSubsystem::GetPickupRadius()
+{
+	return CVarPickupRadius.GetValueOnGameThread();
+}
+
+///--@brief 查询英雄周边格子内的武器并尝试拾取--/
+void UGRBWeaponPickupSubsystem::CheckPickupsAround(AGRBHeroCharacter* InHero, const FVector& InLocation)
+{
+	const float Radius = GetPickupRadius();
+	const float RadiusSquared = FMath::Square(Radius);
+
+	// 拾取会改动哈希表, 先收集再逐个拾取; 每把武器只在一个格子里, 无需去重
+	TArray<AGRBWeapon*, TInlineAllocator<4>> Candidates;
+	Grid.ForEachInRange(Grid.GetCellRange(InLocation, Radius), [&Candidates, &InLocation, RadiusSquared](AGRBWeapon* InWeapon)
+	{
+		if (FVector::DistSquared(InWeapon->GetActorLocation(), InLocation) <= RadiusSquared)
+		{
+			Candidates.Add(InWeapon);
+		}
+	});
+
+	for (AGRBWeapon* const Weapon : Candidates)
+	{
+		Weapon->OnPickupProximity(InHero);
+	}
+}
+#pragma endregion
@@ -84,6 +84,33 @@ public:
 			float OverrideBlendOutTimeForCancelAbility = -1.f,
 			float OverrideBlendOutTimeForStopWhenEndAbility = -1.f);
 
+	/**
+	 * 复用已有任务重播蒙太奇, 供连发射击这类每发都要重播同一段蒙太奇的场合
+	 * InExistingTask 仍处于激活状态且作用于同一骨架时直接在其上 RestartMontage, 事件/取消等委托沿用首次注册的; 否则结束旧任务, 新建任务并激活
+	 * 经由此处创建的任务在蒙太奇播完后不会自行结束, 一直存活到技能结束, 以便下一发继续复用
+	 * @return 实际在播放的任务; 调用方应保存下来作为下次的 InExistingTask
+	 */
+	static UGRBAT_PlayMontageForMeshAndWaitForEvent* PlayOrRestartMontageForMesh(
+			UGRBAT_PlayMontageForMeshAndWaitForEvent* InExistingTask,
+			UGameplayAbility* OwningAbility,
+			USkeletalMeshComponent* Mesh,
+			UAnimMontage* MontageToPlay,
+			float Rate = 1.f,
+			FName StartSection = NAME_None,
+			bool bStopWhenAbilityEnds = true,
+			bool bReplicateMontage = true);
+
+	/**
+	 * 在已激活的任务上重新播放蒙太奇; 不新建任务, 也不重新注册事件与取消委托
+	 * 上一段蒙太奇实例上的回调会先解绑, 因此被新一段打断时不会触发 OnInterrupted; 若随后播放失败, 任务随之结束
+	 * @return 是否成功播放; 任务未激活, 首次播放就失败过或骨架已无动画实例时返回false(任务保持原状)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks")
+	bool RestartMontage(UAnimMontage* InMontageToPlay, float InRate = 1.f, FName InStartSection = NAME_None);
+
+	/** 本任务当前作用的骨架 */
+	USkeletalMeshComponent* GetMesh() const { return Mesh; }
+
 private:
 	// Mesh that the Montage is playing on. Must be owned by the AvatarActor.
 	UPROPERTY()
@@ -122,6 +149,10 @@ private:
 	UPROPERTY()
 	float OverrideBlendOutTimeForStopWhenEndAbility;
 
+	/** 蒙太奇播完后是否保持任务存活以便 RestartMontage 复用 */
+	UPROPERTY()
+	bool bKeepAliveAfterMontageEnded;
+
 	/** Checks if the ability is playing a montage and stops that montage, returns true if a montage was stopped, false if not. */
 	bool StopPlayingMontage(float OverrideBlendOutTime = -1.f);
 
@@ -8,8 +8,12 @@
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FChangeFOVDelegate);
 
+class UGRBFOVAnimatorComponent;
+
 /**
  * 异步任务: 用于动态调控视场角.
+ * 只是一个等待者: 插值本身交给相机持有者身上的 UGRBFOVAnimatorComponent, 由相机管理器推进; 本任务不Tick
+ * 被新的FOV变化打断时直接结束, 不广播 OnTargetFOVReached; 任务提前结束也不会让FOV停在半路
  */
 UCLASS()
 class GRBSHOOTER_API UGRBAT_WaitChangeFOV : public UAbilityTask
@@ -27,27 +31,30 @@ public:
 
 	virtual void Activate() override;
 
-	// Tick function for this task, if bTickingTask == true
-	virtual void TickTask(float DeltaTime) override;
-
 	virtual void OnDestroy(bool AbilityIsEnding) override;
 
 	FChangeFOVDelegate& GetOnTargetFOVReached() { return OnTargetFOVReached; };
 
 protected:
-	bool bIsFinished;
-
-	float StartFOV;
+	///--@brief 动画器上的插值结束--/
+	void OnFOVChangeFinished(uint32 InChangeId, bool bReachedTarget);
 
+protected:
 	float TargetFOV;
 
 	float Duration;
 
-	float TimeChangeStarted;
-
-	float TimeChangeWillEnd;
-
+	UPROPERTY()
 	class UCameraComponent* CameraComponent;
 
+	UPROPERTY()
 	class UCurveFloat* LerpCurve;
+
+	// 实际执行插值的动画器
+	TWeakObjectPtr<UGRBFOVAnimatorComponent> FOVAnimator;
+
+	// 本任务等待的插值ID
+	uint32 ChangeId;
+
+	FDelegateHandle FOVChangeFinishedHandle;
 };
@@ -0,0 +1,82 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "GameplayTagContainer.h"
+#include "GRBAT_WaitInputPressWithTags.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGRBInputPressWithTagsDelegate, float, TimeWaited);
+
+/**
+ * 异步任务: 等待技能输入按下, 且按下时ASC满足标签条件(拥有全部RequiredTags, 不含任何IgnoredTags)
+ * 完全由事件驱动, 不Tick也不轮询:
+ * 1. 订阅ASC的 InputPressed 通用复制事件;
+ * 2. 按下时若标签条件不满足, 本地在按键松开前额外订阅相关标签的增删事件, 条件一旦满足且按键仍按住即触发; 松开后退回只等下一次按下
+ * 3. 服务端收到客户端的确认按下后自行校验标签条件, 不满足则等到门控标签满足再完成, 不采信客户端的判定
+ * 适用于蓄力/按住开火这类需要"按住期间条件满足即生效"的技能, 取代 WaitInputRelease + 反复激活的组合
+ */
+UCLASS()
+class GRBSHOOTER_API UGRBAT_WaitInputPressWithTags : public UAbilityTask
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// 满足标签条件的按下; TimeWaited为自任务激活起的等待时长
+	UPROPERTY(BlueprintAssignable)
+	FGRBInputPressWithTagsDelegate OnPress;
+
+	/**
+	 * 等待满足标签条件的输入按下
+	 * @param RequiredTags 按下时ASC须拥有的全部标签
+	 * @param IgnoredTags 按下时ASC不可拥有的任一标签
+	 * @param bTestAlreadyPressed 激活时若按键已处于按下状态, 是否视为一次按下
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+	static UGRBAT_WaitInputPressWithTags* WaitInputPressWithTags(UGameplayAbility* OwningAbility, FGameplayTagContainer RequiredTags, FGameplayTagContainer IgnoredTags, bool bTestAlreadyPressed = false);
+
+	virtual void Activate() override;
+	virtual void OnDestroy(bool AbilityEnded) override;
+
+protected:
+	///--@brief 输入按下事件--/
+	void OnPressCallback();
+
+	///--@brief 按住期间的输入松开事件--/
+	void OnReleaseCallback();
+
+	///--@brief 按住期间, 门控标签发生增删--/
+	void OnGateTagChanged(const FGameplayTag InTag, int32 InNewCount);
+
+	///--@brief ASC当前是否满足标签条件--/
+	bool AreTagRequirementsMet() const;
+
+	///--@brief (重新)订阅输入按下事件; 远端客户端的事件若已先到则立即处理--/
+	void ListenForPress();
+
+	///--@brief 按下但条件不满足: 订阅门控标签事件直到条件满足; 本地端另订阅松开, 松开即放弃--/
+	void WaitForTagsWhileHeld();
+
+	///--@brief 注销按住期间的订阅--/
+	void StopWaitingForTagsWhileHeld();
+
+	///--@brief 条件满足, 同步预测事件并广播--/
+	void CompletePress();
+
+protected:
+	FGameplayTagContainer RequiredTags;
+
+	FGameplayTagContainer IgnoredTags;
+
+	bool bTestInitialState;
+
+	float StartTime;
+
+	FDelegateHandle PressedHandle;
+
+	FDelegateHandle ReleasedHandle;
+
+	// 按住期间订阅的门控标签事件
+	TArray<TPair<FGameplayTag, FDelegateHandle>> GateTagHandles;
+};
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "Characters/Abilities/GRBPredictionKeyTracker.h"
 #include "GRBAbilitySystemComponent.generated.h"
 
 class USkeletalMeshComponent;
 
+DECLARE_STATS_GROUP(TEXT("GRBAbility"), STATGROUP_GRBAbility, STATCAT_Advanced);
+
 /**
 * Data about montages that were played locally (all montages in case of server. predictive montages in case of client). Never replicated directly.
 * 所有关联本地蒙太奇的数据(所有蒙太奇都在服务器上, 客户端仅负责预测); 并非直接网络同步
@@ -114,6 +117,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ability")
 	virtual FString GetCurrentPredictionKeyStatus();
 
+	///@brief 登记一个GRB技能在本地预测端创建的预测Key, 追踪其确认/拒绝/泄漏; 非本地预测Key或已登记的Key忽略
+	void TracePredictionKey(const UGameplayAbility* InAbility, const FPredictionKey& InKey, EGRBPredictionKeyUsage InUsage);
+
+	///@brief 最近一分钟内被服务端拒绝的预测Key数
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ability")
+	float GetPredictionKeysRejectedPerMinute() const { return PredictionKeyTracker.GetRejectedPerMinute(); }
+
 	/** ///@brief 给Self施加带预测性质效果的BUFF
 	* If this ASC has a valid prediction key, attempt to predictively apply this GE. Used in Pre/PostInteract() on the Interacter's ASC.
 	* If the key is not valid, it will apply the GE without prediction.
@@ -302,6 +312,75 @@ public:
 	//---------------------------------------------------  ------------------------------------------------
 	//---------------------------------------------------  ------------------------------------------------
 
+#pragma region ~ 派生状态缓存 ~
+	// ----------------------------------------------------------------------------------------------------------------
+	//  "X层数 > XRemoval层数" 形式的派生状态(交互中/瞄准中); 仅在两个Tag层数变化时重算, 查询只是一次位测试
+	// ----------------------------------------------------------------------------------------------------------------
+public:
+	///@brief 是否处于交互中: State.Interacting 层数大于 State.InteractingRemoval 层数
+	bool IsInteracting() const { return InteractingTagPairIndex != INDEX_NONE ? IsTagPairActive(InteractingTagPairIndex) : GetTagCount(InteractingTagPair.Tag) > GetTagCount(InteractingTagPair.RemovalTag); }
+
+	///@brief 登记一对派生状态Tag并返回其索引, 已登记则增加一次引用; 超出上限返回INDEX_NONE. 调用方缓存索引, 不再需要时调用ReleaseTagPair
+	int32 FindOrAddTagPair(const FGameplayTag& InTag, const FGameplayTag& InRemovalTag);
+
+	///@brief 释放一次对Tag对的引用; 引用归零时注销两个Tag事件并回收该位
+	void ReleaseTagPair(int32 InPairIndex);
+
+	///@brief 按索引读取派生状态
+	bool IsTagPairActive(int32 InPairIndex) const { return InPairIndex >= 0 && InPairIndex < MaxTagPairs && (TagPairStateBits & (1u << InPairIndex)) != 0; }
+
+protected:
+	///--@brief 派生状态中任一Tag层数变化, 重算该位--/
+	void OnTagPairCountChanged(const FGameplayTag InTag, int32 InNewCount, int32 InPairIndex);
+
+private:
+	// 一对派生状态Tag
+	struct FGRBTagPair
+	{
+		FGameplayTag Tag;
+		FGameplayTag RemovalTag;
+
+		// 引用数; 为0表示空位, 可被复用
+		int32 RefCount = 0;
+
+		// 两个Tag层数变化事件的句柄, 释放时注销
+		FDelegateHandle TagEventHandle;
+		FDelegateHandle RemovalTagEventHandle;
+	};
+
+	// 状态位上限
+	static constexpr int32 MaxTagPairs = 32;
+
+	// 已登记的Tag对; 下标即状态位, 释放后的空位保留以保证其余索引不变
+	TArray<FGRBTagPair, TInlineAllocator<4>> TagPairs;
+
+	// 各Tag对的当前状态
+	uint32 TagPairStateBits = 0;
+
+	// 交互状态
+	FGRBTagPair InteractingTagPair;
+	int32 InteractingTagPairIndex = INDEX_NONE;
+#pragma endregion
+
+	//---------------------------------------------------  ------------------------------------------------
+	//---------------------------------------------------  ------------------------------------------------
+
+#pragma region ~ 预测Key追踪 ~
+protected:
+	///--@brief 每秒汇总一次预测Key统计并检查泄漏; 没有待追踪数据时停下--/
+	void UpdatePredictionKeySummary();
+
+private:
+	// 本地预测端的预测Key生命周期追踪
+	FGRBPredictionKeyTracker PredictionKeyTracker;
+
+	// 汇总定时器
+	FTimerHandle PredictionKeySummaryTimerHandle;
+#pragma endregion
+
+	//---------------------------------------------------  ------------------------------------------------
+	//---------------------------------------------------  ------------------------------------------------
+
 #pragma region ~ 字段 ~
 
 public:
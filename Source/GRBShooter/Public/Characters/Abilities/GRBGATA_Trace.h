@@ -83,7 +83,22 @@ public:
 	///--@brief 主动停止目标选择并进行一系列数据/委托清理--/
 	virtual void StopTargeting();
 
+	///--@brief 粘性配置版本号; 每次Configure或Patch都会递增, 0表示从未配置--/
+	uint32 GetConfigVersion() const { return ConfigVersion; }
+
+	///--@brief 探查器当前的配置是否仍是调用方上次写入的那一份; 是则开火时可跳过重新配置--/
+	bool IsConfigurationCurrent(uint32 InVersion) const { return InVersion != 0 && InVersion == ConfigVersion; }
+
+	///--@brief 仅修补起点相关字段(1P/3P枪口切换); 返回修补后的版本号--/
+	uint32 PatchStartLocation(const FGameplayAbilityTargetingLocationInfo& InStartLocation, bool bInTraceFromPlayerViewPoint);
+
+	///--@brief 仅修补单次Trace命中上限; 值未变化时不递增版本号--/
+	uint32 PatchMaxHitResults(int32 InMaxHitResultsPerTrace);
+
 protected:
+	///--@brief 整体配置写入后递增版本号; 由各子类的Configure末尾调用--/
+	uint32 MarkFullyConfigured();
+
 	///--@brief 为一组命中hit制作 目标数据句柄 并存储它们.--/
 	virtual FGameplayAbilityTargetDataHandle MakeTargetData(const TArray<FHitResult>& HitResults) const;
 
@@ -102,6 +117,9 @@ protected:
 	///--@brief 把一组可视化3D准星从后到前挨个销毁--/
 	virtual void DestroyReticleActors();
 
+	///--@brief 释放在ASC上登记的瞄准Tag对--/
+	void ReleaseAimingTagPair();
+
 public:
 	// 基础扩散因子  Base targeting spread (degrees)
 	UPROPERTY(BlueprintReadWrite, Category = "Accuracy")
@@ -179,4 +197,14 @@ protected:
 	
 	// 在持续trace情况下, 保存到的一组hit结果(这里设计为队列, 认新加进来的命中结果)
 	TArray<FHitResult> m_QueuePersistHits;
+
+private:
+	// 粘性配置版本号; 探查器可能被同一把武器上的多个技能复用, 调用方据此判断配置是否被别人改写过
+	uint32 ConfigVersion = 0;
+
+	// 登记瞄准Tag对的ASC及其返回的索引; 探查器跨多发复用, 引用一直持有到换ASC/换Tag或EndPlay
+	TWeakObjectPtr<class UGRBAbilitySystemComponent> AimingTagPairASC;
+	int32 AimingTagPairIndex = INDEX_NONE;
+	FGameplayTag AimingTagPairTag;
+	FGameplayTag AimingTagPairRemovalTag;
 };
@@ -6,6 +6,7 @@
 #include "GRBShooter/GRBShooter.h"
 #include "GRBGameplayAbility.generated.h"
 
+class UGRBAbilitySystemComponent;
 class UGRBHUDReticle;
 class USkeletalMeshComponent;
 
@@ -49,6 +50,12 @@ public:
 	// ~Start Implements UGameplayAbility 
 	/// @brief 虚方法,当avatarActor初始化绑定键位的时候会被调用
 	virtual void OnAvatarSet(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+	///--@brief 虚接口: 技能被授予; 实例化的技能在此登记交互Tag对并缓存索引--/
+	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+	///--@brief 虚接口: 技能被移除; 释放授予时登记的交互Tag对--/
+	virtual void OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+	///--@brief 虚接口: 激活前的准备; 这里登记激活预测Key以追踪其确认/拒绝--/
+	virtual void PreActivate(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, FOnGameplayAbilityEnded::FDelegate* OnGameplayAbilityEndedDelegate, const FGameplayEventData* TriggerEventData = nullptr) override;
 	///--@brief 虚接口： 检查技能发动条件--/
 	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
 	///--@brief 虚接口: 检查技能发动消耗成本--/
@@ -224,6 +231,11 @@ protected:
 
 	// 在执行交互移除时刻的标签
 	FGameplayTag InteractingRemovalTag;
+
+private:
+	// 授予时在ASC上登记的交互Tag对索引; 非实例化技能(CDO)不缓存
+	TWeakObjectPtr<UGRBAbilitySystemComponent> InteractingTagPairASC;
+	int32 InteractingTagPairIndex = INDEX_NONE;
 };
 //
 //
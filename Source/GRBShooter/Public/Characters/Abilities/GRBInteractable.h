@@ -162,5 +162,6 @@ public:
 	void InteractableCancelInteraction_Implementation(UPrimitiveComponent* InteractionComponent);
 
 protected:
-	TMap<UPrimitiveComponent*, TArray<AActor*>> Interacters;
+	// 交互区域 -> 正在与之交互的Actor; 弱引用, 交互者中途销毁不会留下悬空指针
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, TArray<TWeakObjectPtr<AActor>>> Interacters;
 };
@@ -0,0 +1,75 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "GRBUniformGrid.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GRBInteractableRegistry.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * 世界级可交互物注册表
+ * 实现了 IGRBInteractable 的Actor把自己的交互区域(UPrimitiveComponent)登记进来; 各端各自维护, 不参与同步
+ * 静态交互区域按包围盒落进均匀网格(格子边长 GRB.interact.CellSize); 可移动的区域(如倒地待救的玩家)数量少, 单独线性检查
+ * 玩家扫描交互目标时只查周边格子, 不再每帧发射线
+ */
+UCLASS()
+class GRBSHOOTER_API UGRBInteractableRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	///--@brief 取世界上的注册表--/
+	static UGRBInteractableRegistry* Get(const UObject* InWorldContextObject);
+
+	///--@brief 取消交互时要取消的技能Tag组; 只构建一次--/
+	static const FGameplayTagContainer& GetInteractionAbilityTags();
+
+	///--@brief 登记交互区域; 所属Actor须实现 IGRBInteractable. 已登记时按当前包围盒重新入格--/
+	UFUNCTION(BlueprintCallable, Category = "GRBShooter|Interaction")
+	void RegisterInteractable(UPrimitiveComponent* InInteractionComponent);
+
+	///--@brief 注销交互区域--/
+	UFUNCTION(BlueprintCallable, Category = "GRBShooter|Interaction")
+	void UnregisterInteractable(UPrimitiveComponent* InInteractionComponent);
+
+	///--@brief 收集范围内当前可交互的区域, 按距离由近到远; 返回个数--/
+	UFUNCTION(BlueprintCallable, Category = "GRBShooter|Interaction")
+	int32 QueryInteractables(const FVector& InLocation, float InRadius, TArray<UPrimitiveComponent*>& OutInteractionComponents) const;
+
+	///--@brief 范围内且处于视锥内(与视线夹角余弦 >= InMinViewDot)最近的可交互区域; 没有则返回空--/
+	UFUNCTION(BlueprintCallable, Category = "GRBShooter|Interaction")
+	UPrimitiveComponent* FindBestInteractable(const FVector& InViewLocation, const FVector& InViewDirection, float InRadius, float InMinViewDot = 0.7f) const;
+
+	///--@brief 已登记的交互区域数量--/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Interaction")
+	int32 GetNumInteractables() const { return StaticCellRanges.Num() + MovableInteractables.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FInteractableGrid = TGRBUniformGrid<UPrimitiveComponent>;
+
+	///--@brief 收集范围内的候选区域(未做可交互性检查, 已去重)--/
+	void GatherCandidates(const FVector& InLocation, float InRadius, TArray<UPrimitiveComponent*, TInlineAllocator<16>>& OutCandidates) const;
+
+	///--@brief 区域是否仍可交互--/
+	static bool IsAvailable(UPrimitiveComponent* InInteractionComponent);
+
+private:
+	// 网格: 静态交互区域按包围盒落进其覆盖的格子
+	FInteractableGrid Grid;
+
+	// 静态交互区域 -> 覆盖的格子范围
+	TMap<TObjectKey<UPrimitiveComponent>, FInteractableGrid::FCellRange> StaticCellRanges;
+
+	// 可移动的交互区域
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> MovableInteractables;
+};
@@ -0,0 +1,72 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayPrediction.h"
+#include "Trace/Trace.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+
+// 预测Key结构化追踪通道; 启动参数 -trace=default,GRBPrediction
+UE_TRACE_CHANNEL_EXTERN(GRBPredictionChannel, GRBSHOOTER_API)
+
+/*
+ * 预测Key的创建来源
+ */
+enum class EGRBPredictionKeyUsage : uint8
+{
+	// 技能激活
+	Activation,
+	// 发送目标数据时新开的预测窗口
+	TargetData,
+	// 其它
+	Other,
+};
+
+/**
+ * 预测Key生命周期追踪; 每个本地预测端的ASC持有一份
+ * 登记GRB技能创建的预测Key及其依赖的Base Key, 挂接服务端确认(CaughtUp)/拒绝(Rejected)回调, 统计结论延迟与每分钟拒绝数
+ * 超过 GRB.prediction.LeakSeconds 仍无结论的Key记为泄漏
+ * 结构化事件写入 GRBPrediction 追踪通道; 每分钟拒绝数/未结论Key数同时写入Insights计数器, 每次拒绝打一个书签
+ */
+struct GRBSHOOTER_API FGRBPredictionKeyTracker
+{
+public:
+	///--@brief 登记一个新的预测Key并挂接结论回调; 返回是否登记成功(非本地预测Key/已登记的Key不重复登记)--/
+	bool TraceKeyCreated(UAbilitySystemComponent* InASC, const UGameplayAbility* InAbility, const FPredictionKey& InKey, EGRBPredictionKeyUsage InUsage, double InNow);
+
+	///--@brief 刷新每分钟统计并检查泄漏; 返回是否仍有需要继续汇总的数据--/
+	bool UpdateSummary(double InNow);
+
+	///--@brief 最近一分钟内被拒绝的Key数--/
+	float GetRejectedPerMinute() const { return RecentRejectionTimes.Num(); }
+
+	///--@brief 尚无结论的Key数--/
+	int32 GetOutstandingKeyCount() const { return OutstandingKeys.Num(); }
+
+private:
+	///--@brief 服务端对Key给出结论(确认或拒绝)--/
+	void OnKeyResolved(FPredictionKey::KeyType InKey, bool bRejected, double InNow);
+
+	///--@brief 丢弃一分钟以前的时间戳--/
+	static void TrimOlderThan(TArray<double>& InOutTimes, double InCutoff);
+
+private:
+	// 一个尚无结论的Key
+	struct FTracedPredictionKey
+	{
+		FName AbilityName;
+		double CreateTime = 0.0;
+		FPredictionKey::KeyType BaseKey = 0;
+		EGRBPredictionKeyUsage Usage = EGRBPredictionKeyUsage::Other;
+	};
+
+	// 尚无结论的Key
+	TMap<FPredictionKey::KeyType, FTracedPredictionKey> OutstandingKeys;
+
+	// 最近一分钟的创建/拒绝时间
+	TArray<double> RecentCreationTimes;
+	TArray<double> RecentRejectionTimes;
+};
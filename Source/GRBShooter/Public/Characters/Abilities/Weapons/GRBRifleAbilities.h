@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Characters/Abilities/GRBGameplayAbility.h"
+#include "Weapons/GRBWeaponDefinition.h"
 #include "GRBRifleAbilities.generated.h"
 
 
@@ -54,6 +55,12 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void CheckAndSetupCacheables();
 
+	///--@brief 读取武器定义烘焙好的开火参数; 未配置武器定义时沿用技能自身默认值--/
+	void ApplyWeaponFireParams();
+
+	///--@brief 装备后一次性配置射线探查器; 之后逐发开火不再重新Configure--/
+	void ConfigureLineTraceTargetActor();
+
 public:
 	// 武器1P视角下的枪皮
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
@@ -79,6 +86,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
 	class UGRBAT_ServerWaitForClientTargetData* mServerWaitTargetDataTask = nullptr;
 
+	// 异步任务: 开火蒙太奇; 连发期间复用同一个任务重播
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
+	class UGRBAT_PlayMontageForMeshAndWaitForEvent* mFireMontageTask = nullptr;
+
 	// 单回合射击消耗的弹量
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
 	int32 mAmmoCost = 1;
@@ -126,6 +137,29 @@ public:
 	// 副开火技能会用到的场景探查器
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
 	class AGRBGATA_LineTrace* mLineTraceTargetActor = nullptr;
+
+	// 装备后写入探查器的弹道参数
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBPrimaryInstantBussiness")
+	FGRBWeaponTraceParams mTraceParams;
+
+	// 上次写入探查器时的配置版本号; 与探查器当前版本一致时开火跳过重新配置
+	uint32 mTraceConfigVersion = 0;
+
+	// 开火伤害BUFF
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBPrimaryInstantBussiness")
+	TSubclassOf<class UGameplayEffect> mDamageEffectClass;
+
+	// 腰射开火蒙太奇
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBPrimaryInstantBussiness")
+	class UAnimMontage* mFireMontage = nullptr;
+
+	// 瞄准开火蒙太奇
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBPrimaryInstantBussiness")
+	class UAnimMontage* mAimFireMontage = nullptr;
+
+	// 开火特效CueTag
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBPrimaryInstantBussiness")
+	FGameplayTag mFireCueTag;
 };
 
 
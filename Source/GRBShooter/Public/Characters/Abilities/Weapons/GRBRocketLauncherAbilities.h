@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Characters/Abilities/GRBGameplayAbility.h"
+#include "Weapons/GRBWeaponDefinition.h"
 #include "GRBRocketLauncherAbilities.generated.h"
 
 
@@ -55,6 +56,12 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void CheckAndSetupCacheables();
 
+	///--@brief 装备后一次性配置射线探查器; 之后逐发开火不再重新Configure--/
+	void ConfigureLineTraceTargetActor();
+
+	///--@brief 探查器配置被改写过则整体重配; 否则仅在视角切换后修补起点与是否从视角摄像机Trace--/
+	void UpdateTracePerspective();
+
 public:
 	// 武器1P视角下的枪皮
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
@@ -80,6 +87,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
 	class UGRBAT_ServerWaitForClientTargetData* mServerWaitTargetDataTask = nullptr;
 
+	// 异步任务: 开火蒙太奇; 连发期间复用同一个任务重播
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
+	class UGRBAT_PlayMontageForMeshAndWaitForEvent* mFireMontageTask = nullptr;
+
 	// 上次的射击时刻
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
 	float mTimeOfLastShot = 0.f;
@@ -103,6 +114,20 @@ public:
 	// 副开火技能会用到的场景探查器
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
 	class AGRBGATA_LineTrace* mLineTraceTargetActor = nullptr;
+
+	// 装备后写入探查器的弹道参数
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBPrimaryInstantBussiness")
+	FGRBWeaponTraceParams mTraceParams;
+
+	// 探查器当前按第一视角配置
+	bool mbTraceConfiguredFirstPerson = true;
+
+	// 上次写入探查器时的配置版本号; 与探查器当前版本一致时跳过重新配置
+	uint32 mTraceConfigVersion = 0;
+
+	// 是否改由 UGRBProjectileManagerSubsystem 模拟轻量弹丸, 而非生成 AGRBProjectile 实体
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GRBPrimaryInstantBussiness")
+	bool mUseLightweightProjectile = false;
 };
 
 
@@ -217,9 +242,18 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void CheckAndSetupCacheables();
 
+	///--@brief 装备后一次性配置球型探查器; 之后每回合索敌只更新起点与命中上限--/
+	void ConfigureSphereTraceTargetActor();
+
 	UFUNCTION()
 	void OnManuallyStopRocketSearch(float InTimeHeld);
 
+	///--@brief 复位FOV的插值结束(到达或被打断), 结束技能--/
+	void OnZoomResetFinished(uint32 InChangeId, bool bReachedTarget);
+
+	///--@brief 注销复位FOV的结束回调与计时--/
+	void ClearZoomReset();
+
 public:
 	// 武器1P视角下的枪皮
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness|Components")
@@ -249,13 +283,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
 	struct FActiveGameplayEffectHandle mGE_AimingRemovalBuffHandle = FActiveGameplayEffectHandle();
 
-	// 异步任务: 第一人称下的 等待切换FOV
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
-	class UGRBAT_WaitChangeFOV* m1PZoomInTask = nullptr;
+	// 复位视角的FOV插值ID; 0表示没有进行中的复位
+	uint32 m1PZoomResetChangeId = 0;
 
-	// 异步任务: 第一人称下的 复位视角
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
-	class UGRBAT_WaitChangeFOV* m1PZoomResetTask = nullptr;
+	// 复位视角插值结束回调
+	FDelegateHandle m1PZoomResetFinishedHandle;
+
+	// 没有本地相机推进插值时(服务端), 按复位时长计时后结束技能
+	FTimerHandle m1PZoomResetTimerHandle;
 
 	// 欲切换到的FOV视场角1p
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
@@ -281,6 +316,10 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
 	class UGRBAT_ServerWaitForClientTargetData* mServerWaitTargetDataTask = nullptr;
 
+	// 异步任务: 开火蒙太奇; 连发期间复用同一个任务重播
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
+	class UGRBAT_PlayMontageForMeshAndWaitForEvent* mFireMontageTask = nullptr;
+
 	// 异步任务: 等待探查器数据并据此完成双端射击任务
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
 	class UGRBAT_WaitTargetDataUsingActor* mWaitTargetDataWithActorTask = nullptr;
@@ -329,6 +368,24 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
 	class AGRBGATA_SphereTrace* mSphereTraceTargetActor = nullptr;
 
+	// 装备后写入探查器的弹道参数
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="GRBSecondaryInstantBussiness")
+	FGRBWeaponTraceParams mTraceParams;
+
+	// 探查器当前按第一视角配置
+	bool mbTraceConfiguredFirstPerson = true;
+
+	// 上次写入探查器时的配置版本号; 与探查器当前版本一致时跳过重新配置
+	uint32 mTraceConfigVersion = 0;
+
+	// 是否改由 UGRBProjectileManagerSubsystem 模拟轻量追踪弹, 而非生成 AGRBProjectile 实体
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
+	bool mUseLightweightProjectile = false;
+
+	// 轻量追踪弹的追踪加速度幅值
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
+	float mHomingAccelerationMagnitude = 20000.0f;
+
 	// 关联的玩家控制器
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category="GRBSecondaryInstantBussiness")
 	class AGRBPlayerController* mGRBPlayerController = nullptr;
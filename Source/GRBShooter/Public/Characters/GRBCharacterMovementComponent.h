@@ -3,8 +3,59 @@
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameplayTagContainer.h"
+#include "GameplayEffectTypes.h"
 #include "GRBCharacterMovementComponent.generated.h"
 
+class UGRBAbilitySystemComponent;
+class AGRBCharacterBase;
+
+/*
+ * 移动纠正的诱因归类; 按从上到下的优先级归到第一个命中的类别
+ */
+UENUM(BlueprintType)
+enum class EGRBMoveCorrectionCause : uint8
+{
+	// 双端技能速度修正不一致(击倒/交互/死亡)
+	SpeedModifier		UMETA(DisplayName = "Speed Modifier"),
+	// 双端移动模式不一致(落地/起跳时机等)
+	MovementMode		UMETA(DisplayName = "Movement Mode"),
+	// 冲刺/ADS输入在本次移动中切换
+	SprintADS			UMETA(DisplayName = "Sprint/ADS"),
+	// 以上皆非, 归为物理/碰撞差异
+	Physics				UMETA(DisplayName = "Physics"),
+	MAX					UMETA(Hidden)
+};
+
+/*
+ * 单条连接上最近一个统计窗口的移动纠正指标
+ * 服务端侧记录纠正相关指标, 主控客户端侧记录SavedMove缓冲深度与合并率
+ */
+USTRUCT(BlueprintType)
+struct FGRBMoveCorrectionMetrics
+{
+	GENERATED_BODY()
+
+public:
+	// 每秒纠正次数
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Movement")
+	float CorrectionsPerSecond = 0.0f;
+
+	// 纠正时的平均位置误差(cm)
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Movement")
+	float AverageErrorDistance = 0.0f;
+
+	// 窗口结束时尚未被服务端确认的SavedMove数量
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Movement")
+	int32 SavedMoveDepth = 0;
+
+	// 被合并的移动占全部移动的比例
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Movement")
+	float CombinedMoveRatio = 0.0f;
+
+	// 按诱因统计的纠正次数, 下标为 EGRBMoveCorrectionCause
+	int32 CorrectionsByCause[static_cast<uint8>(EGRBMoveCorrectionCause::MAX)] = {};
+};
+
 /**
  * 定制的GRB人物移动组件
  */
@@ -50,12 +101,51 @@ public:
 		///@brief 方法的核心作用就是恢复和应用之前保存的角色移动状态，以确保网络回放过程中角色状态的一致性
 		virtual void PrepMoveFor(class ACharacter* Character) override;
 
+		///@brief 把旧的移动合并进本次移动; 这里只额外统计合并次数
+		virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+
+		///@brief 本次移动时生效的量化速度修正
+		uint8 GetSavedSpeedModifier() const { return SavedSpeedModifier; }
+
 	protected:
 		// Sprint; 业务：是否启用冲刺
 		uint8 SavedRequestToStartSprinting : 1;
 
 		// Aim Down Sights；业务；是否开启ADS瞄准
 		uint8 SavedRequestToStartADS : 1;
+
+		// 技能驱动的速度修正(击倒/交互/死亡), 量化为一个字节; 见 UGRBCharacterMovementComponent::QuantizeSpeedModifier
+		uint8 SavedSpeedModifier;
+	};
+
+	/** FCharacterNetworkMoveData
+	 * 客户端发往服务端的单个移动数据包; 在引擎自带的字段之外额外携带一个字节的量化速度修正
+	 * 压缩标志位只剩 FLAG_Custom_2/3 两个位, 放不下击倒倍率这样的连续量, 因此走扩展包
+	 */
+	class FGRBCharacterNetworkMoveData : public FCharacterNetworkMoveData
+	{
+	public:
+		typedef FCharacterNetworkMoveData Super;
+
+		///@brief 客户端从SavedMove中填充要发送的数据
+		virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+		///@brief 双端序列化; 在引擎字段后追加一个字节
+		virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+	public:
+		uint8 SpeedModifier = 0;
+	};
+
+	/** FCharacterNetworkMoveDataContainer
+	 * 把 New/Pending/Old 三个移动数据包替换为携带速度修正的版本
+	 */
+	class FGRBCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+	{
+	public:
+		FGRBCharacterNetworkMoveDataContainer();
+
+		FGRBCharacterNetworkMoveData GRBDefaultMoveData[3];
 	};
 
 	
@@ -79,6 +169,10 @@ public:
 
 public:
 	UGRBCharacterMovementComponent();
+	// ~Start Implements UActorComponent
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// ~End Implements
 	// ~Start Implements UCharacterMovementComponent
 	/** 方法的主要作用是提供角色在当前状态下的最大可能移动速度。这个方法可能会根据多种状态和条件返回不同的速度值*/
 	virtual float GetMaxSpeed() const override;
@@ -86,6 +180,12 @@ public:
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	/**　返回一个数据包实例，这个实例用于存储客户端预测数据。这些数据包括角色的历史移动状态、时间戳、输入状态等信息 */
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	/** 服务端执行一次客户端发来的移动; 在此期间采用双端速度修正中更严格的一方 */
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+	/** 客户端收到纠正后回放未确认的移动; 回放期间速度修正取自各SavedMove */
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+	/** 服务端校验客户端位置误差; 顺带统计纠正率 */
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
 	// ~End Implements
 
 public:
@@ -100,7 +200,99 @@ public:
 	void StartAimDownSights();
 	UFUNCTION(BlueprintCallable, Category = "Aim Down Sights")
 	void StopAimDownSights();
-	
+
+#pragma region ~ 速度修正缓存 ~
+public:
+	///--@brief 向ASC注册Tag/属性变化回调并全量刷新一次缓存; 由ASC的InitAbilityActorInfo调用, 重复调用只做刷新--/
+	void BindSpeedModifierDelegates(UGRBAbilitySystemComponent* InASC);
+
+	///--@brief 注销ASC回调; 之后GetMaxSpeed回退为每次调用时实时读取宿主状态--/
+	void UnbindSpeedModifierDelegates();
+
+	///--@brief 全量刷新速度修正缓存; 仅在绑定或ASC重新初始化时调用--/
+	void RefreshSpeedModifierState();
+
+	///--@brief 由缓存状态得出的量化速度修正; 0为不可移动, GRBSpeedModifierFull为不受技能影响--/
+	uint8 GetQuantizedSpeedModifier() const;
+
+	///--@brief 速度倍率与单字节之间的量化/反量化; 精度0.01, 上限2.55--/
+	static uint8 QuantizeSpeedModifier(float InMultiplier);
+	static float DequantizeSpeedModifier(uint8 InSpeedModifier);
+
+	///--@brief 本组件作为服务端时, 被纠正的移动占已校验移动的比例--/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Movement")
+	float GetServerCorrectionRate() const { return ServerCheckedMoveCount > 0 ? static_cast<float>(ServerCorrectionCount) / ServerCheckedMoveCount : 0.0f; }
+
+	// 不受任何技能修正时的量化值
+	static constexpr uint8 GRBSpeedModifierFull = 100;
+
+	///--@brief 最近一个统计窗口(1秒)的移动纠正指标--/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Movement")
+	FGRBMoveCorrectionMetrics GetMoveCorrectionMetrics() const { return MoveCorrectionMetrics; }
+
+private:
+	// 击倒Tag的增删
+	void OnKnockedDownTagChanged(const FGameplayTag InTag, int32 InNewCount);
+	// 移速属性变化
+	void OnMoveSpeedChanged(const FOnAttributeChangeData& InData);
+	// 生命值属性变化, 用来刷新存活状态
+	void OnHealthChanged(const FOnAttributeChangeData& InData);
+	// 由存活/击倒/交互状态得出量化速度修正
+	uint8 MakeQuantizedSpeedModifier(bool bInIsAlive, bool bInIsKnockedDown, bool bInIsInteracting) const;
+
+private:
+	// 回调注册所在的ASC; 交互状态直接读它缓存的派生状态位
+	TWeakObjectPtr<UGRBAbilitySystemComponent> SpeedModifierASC;
+	FDelegateHandle KnockedDownTagChangedHandle;
+	FDelegateHandle MoveSpeedChangedHandle;
+	FDelegateHandle HealthChangedHandle;
+
+	// 缓存的移速属性当前值
+	float CachedMoveSpeed;
+	// 缓存的宿主状态; GetMaxSpeed只读取这些位(交互状态读ASC缓存的派生状态位), 不做Tag查询
+	uint8 bCachedIsAlive : 1;
+	uint8 bCachedIsKnockedDown : 1;
+	// 是否已向ASC注册回调
+	uint8 bSpeedModifierDelegatesBound : 1;
+
+	// 服务端执行客户端移动/客户端回放期间生效的速度修正; 此时不读缓存
+	uint8 bHasSpeedModifierOverride : 1;
+	uint8 SpeedModifierOverride;
+
+	// 作为服务端时已校验/已纠正的移动数
+	uint32 ServerCheckedMoveCount = 0;
+	uint32 ServerCorrectionCount = 0;
+
+	// 携带速度修正的移动数据包
+	FGRBCharacterNetworkMoveDataContainer GRBMoveDataContainer;
+#pragma endregion
+
+#pragma region ~ 移动纠正统计 ~
+private:
+	///--@brief 对一次服务端纠正做诱因归类并计入窗口--/
+	void RecordServerCorrection(const FVector& ClientWorldLocation, uint8 ClientMovementMode);
+
+	///--@brief 累计统计窗口, 满1秒后结算为 MoveCorrectionMetrics; 每帧把最近的结算值写入Stats/CSV--/
+	void UpdateMoveCorrectionMetrics(float DeltaTime);
+
+private:
+	// 最近一个窗口的结算结果
+	FGRBMoveCorrectionMetrics MoveCorrectionMetrics;
+
+	// 当前窗口的累计量
+	float CorrectionWindowTime = 0.0f;
+	int32 WindowCorrections = 0;
+	float WindowErrorDistanceSum = 0.0f;
+	int32 WindowClientMoves = 0;
+	int32 WindowCombinedMoves = 0;
+	int32 WindowCorrectionsByCause[static_cast<uint8>(EGRBMoveCorrectionCause::MAX)] = {};
+
+	// 服务端最近一次执行的客户端移动的信息, 供随后的误差校验做归因
+	uint8 LastServerMoveInputFlags = 0;
+	uint8 bLastServerMoveInputChanged : 1;
+	uint8 bLastServerMoveSpeedModifierMismatch : 1;
+#pragma endregion
+
 protected:
 	// 各种输入操作的倍率
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Speed")
@@ -116,7 +308,5 @@ protected:
 
 	// 一些伴随移动组件会使用到的状态Tag
 	FGameplayTag KnockedDownTag;
-	FGameplayTag InteractingTag;
-	FGameplayTag InteractingRemovalTag;
 	
 };
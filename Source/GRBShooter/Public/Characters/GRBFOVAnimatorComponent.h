@@ -0,0 +1,76 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GRBFOVAnimatorComponent.generated.h"
+
+class UCameraComponent;
+class UCurveFloat;
+class AGRBPlayerCameraManager;
+
+/** 一段FOV插值结束; ChangeId为StartFOVChange的返回值, bReachedTarget为false表示被新的插值或StopFOVChange打断 */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FGRBOnFOVChangeFinished, uint32 /*ChangeId*/, bool /*bReachedTarget*/);
+
+/**
+ * 视场角动画器; 每个持有相机的Actor一份, 同一时刻只维护一段FOV插值
+ * 自身不Tick, 由本地玩家的 AGRBPlayerCameraManager 在相机更新前统一推进, 插值进度与相机帧严格同步
+ * 找不到可推进它的相机管理器时(服务端上的远端玩家/AI)直接设到目标值并立即结束, 保证等待者不会卡住
+ */
+UCLASS(ClassGroup = (GRBShooter), meta = (BlueprintSpawnableComponent))
+class GRBSHOOTER_API UGRBFOVAnimatorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGRBFOVAnimatorComponent();
+
+	///--@brief 取Actor身上的动画器, 没有则动态创建并注册--/
+	static UGRBFOVAnimatorComponent* FindOrAddFOVAnimator(AActor* InOwner);
+
+	///--@brief 开始一段FOV插值, 打断当前进行中的那段; 曲线值域0~1, 为空则线性插值. 返回本段的ID--/
+	uint32 StartFOVChange(UCameraComponent* InCamera, float InTargetFOV, float InDuration, UCurveFloat* InOptionalInterpolationCurve);
+
+	///--@brief 打断当前插值, FOV停留在当前值--/
+	void StopFOVChange();
+
+	///--@brief 由相机管理器在每帧相机更新前调用; 返回是否仍在插值--/
+	bool AdvanceFOVChange(float DeltaTime);
+
+	///--@brief 是否有进行中的插值--/
+	bool IsChangingFOV() const { return ActiveChangeId != 0; }
+
+	///--@brief 下一次StartFOVChange将返回的ID; StartFOVChange在打断旧插值之前就占用它, 等待者据此在开始前先挂好回调--/
+	uint32 GetNextFOVChangeId() const { return NextChangeId; }
+
+	// 插值结束(到达或被打断)
+	FGRBOnFOVChangeFinished OnFOVChangeFinished;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	///--@brief 结束当前插值并广播--/
+	void FinishFOVChange(bool bReachedTarget);
+
+	///--@brief 负责推进本组件的本地相机管理器; 非本地玩家返回空--/
+	AGRBPlayerCameraManager* FindCameraManager() const;
+
+private:
+	// 正在插值的相机
+	TWeakObjectPtr<UCameraComponent> Camera;
+
+	// 可选的插值曲线
+	UPROPERTY(Transient)
+	UCurveFloat* LerpCurve = nullptr;
+
+	float StartFOV = 90.0f;
+	float TargetFOV = 90.0f;
+	float Duration = 0.0f;
+	float ElapsedTime = 0.0f;
+
+	// 进行中的插值ID, 0表示空闲
+	uint32 ActiveChangeId = 0;
+	uint32 NextChangeId = 1;
+};
@@ -0,0 +1,102 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GRBInventoryComponent.generated.h"
+
+class AGRBHeroCharacter;
+class AGRBWeapon;
+
+/** 当前装备槽位变化; 旧/新武器可能为空 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGRBOnEquippedWeaponChanged, AGRBWeapon*, OldWeapon, AGRBWeapon*, NewWeapon);
+
+/**
+ * 英雄武器背包; 固定槽位数组, 槽位下标即武器ID
+ * 武器入包时一次性挂接到英雄身上, 之后装备切换只在武器预先算好的网格状态(EGRBWeaponMeshState)间翻转, 不再重新挂接
+ * 未装备的武器全部收起: 双视角枪皮隐藏, 动画Tick停掉或降为仅渲染时Tick, 背着5把枪不会有10个始终Tick的骨骼网格
+ * 槽位与当前槽位由服务端写入并同步, 各端在OnRep里就地翻转网格状态
+ */
+UCLASS(ClassGroup = (GRBShooter), meta = (BlueprintSpawnableComponent))
+class GRBSHOOTER_API UGRBInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGRBInventoryComponent();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	///--@brief 取Actor身上的背包组件--/
+	static UGRBInventoryComponent* FindInventory(const AActor* InOwner);
+
+	///--@brief 放入第一个空槽位并收起; 仅服务端. 返回槽位下标, 背包已满/已在包内返回 INDEX_NONE--/
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "GRBShooter|Inventory")
+	int32 AddWeapon(AGRBWeapon* InWeapon);
+
+	///--@brief 从背包移除; 仅服务端. 移除的是当前武器时当前槽位置空--/
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "GRBShooter|Inventory")
+	bool RemoveWeapon(AGRBWeapon* InWeapon);
+
+	///--@brief 装备指定槽位; 仅服务端. 只翻转新旧两把武器的网格状态, O(1)--/
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "GRBShooter|Inventory")
+	bool EquipSlot(int32 InSlotIndex);
+
+	///--@brief 视角切换后重新套用当前武器的装备状态(1P/3P)--/
+	UFUNCTION(BlueprintCallable, Category = "GRBShooter|Inventory")
+	void RefreshEquippedMeshState();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Inventory")
+	AGRBWeapon* GetCurrentWeapon() const { return GetWeaponInSlot(CurrentSlotIndex); }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Inventory")
+	AGRBWeapon* GetWeaponInSlot(int32 InSlotIndex) const { return Slots.IsValidIndex(InSlotIndex) ? Slots[InSlotIndex] : nullptr; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Inventory")
+	int32 GetCurrentSlotIndex() const { return CurrentSlotIndex; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Inventory")
+	int32 FindSlotOfWeapon(const AGRBWeapon* InWeapon) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|Inventory")
+	int32 GetNumSlots() const { return Slots.Num(); }
+
+public:
+	// 当前装备的武器变化; 各端都会广播
+	UPROPERTY(BlueprintAssignable, Category = "GRBShooter|Inventory")
+	FGRBOnEquippedWeaponChanged OnEquippedWeaponChanged;
+
+protected:
+	virtual void InitializeComponent() override;
+
+	UFUNCTION()
+	void OnRep_Slots(const TArray<AGRBWeapon*>& OldSlots);
+
+	UFUNCTION()
+	void OnRep_CurrentSlotIndex(int32 OldSlotIndex);
+
+private:
+	///--@brief 从旧槽位切到新槽位: 收起旧武器, 装备新武器--/
+	void SwitchEquippedSlot(int32 InOldSlotIndex, int32 InNewSlotIndex);
+
+	///--@brief 按英雄当前视角套用装备状态--/
+	void ApplyEquippedState(AGRBWeapon* InWeapon) const;
+
+	///--@brief 背包所属英雄--/
+	AGRBHeroCharacter* GetOwningHero() const;
+
+protected:
+	// 槽位数; 背包容量固定
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Inventory", meta = (ClampMin = "1"))
+	int32 NumSlots = 5;
+
+private:
+	// 固定槽位; 空槽为nullptr
+	UPROPERTY(ReplicatedUsing = OnRep_Slots)
+	TArray<AGRBWeapon*> Slots;
+
+	// 当前装备的槽位; INDEX_NONE 表示空手
+	UPROPERTY(ReplicatedUsing = OnRep_CurrentSlotIndex)
+	int32 CurrentSlotIndex = INDEX_NONE;
+};
@@ -7,6 +7,7 @@
 #include "GRBHeroCharacter.generated.h"
 
 class AGRBWeapon;
+class UGRBInventoryComponent;
 /**
 * A player or AI controlled hero character.
  */
@@ -16,9 +17,16 @@ class GRBSHOOTER_API AGRBHeroCharacter : public AGRBCharacterBase
 	GENERATED_BODY()
 
 public:
+	AGRBHeroCharacter(const FObjectInitializer& ObjectInitializer);
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|Inventory")
 	AGRBWeapon* GetCurrentWeapon() const;
 
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GASShooter|Inventory")
+	UGRBInventoryComponent* GetInventoryComponent() const { return InventoryComponent; }
+
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSHeroCharacter")
 	virtual bool IsInFirstPersonPerspective() const;
 
@@ -33,4 +41,9 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSHeroCharacter")
 	void SetThirdPersonCameraBoom(const float InLength) { ThirdPersonCameraBoom->TargetArmLength = InLength; }
+
+protected:
+	// 武器背包; 固定槽位, 装备切换只翻转武器枪皮状态
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GASShooter|Inventory")
+	UGRBInventoryComponent* InventoryComponent;
 };
@@ -0,0 +1,66 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GRBNetUpdatePolicy.generated.h"
+
+/**
+ * 网络同步节流策略: 按观察者的距离与视野朝向缩放同步优先级, 并配置自适应同步频率的上下限
+ * 弹丸, 武器, 玩家状态各自持有一份, 在蓝图默认值里按需调参
+ * 主控连接(本Actor的拥有者)始终不受节流影响
+ */
+USTRUCT(BlueprintType)
+struct GRBSHOOTER_API FGRBNetUpdatePolicy
+{
+	GENERATED_BODY()
+
+public:
+	FGRBNetUpdatePolicy()
+	{
+	}
+
+	FGRBNetUpdatePolicy(float InMaxNetUpdateFrequency, float InMinNetUpdateFrequency)
+		: MaxNetUpdateFrequency(InMaxNetUpdateFrequency)
+		, MinNetUpdateFrequency(InMinNetUpdateFrequency)
+	{
+	}
+
+	///--@brief 把同步频率上下限与裁剪距离写回Actor; 仅服务端生效--/
+	void ApplyTo(AActor* InActor) const;
+
+	///--@brief 在Actor自身GetNetPriority的基础上按距离/视野朝向做缩放--/
+	float ScaleNetPriority(float InPriority, const AActor* InActor, const FVector& InViewPos, const FVector& InViewDir, const AActor* InViewer, const AActor* InViewTarget) const;
+
+	///--@brief 观察者是否为本Actor的主控连接--/
+	static bool IsViewerOwner(const AActor* InActor, const AActor* InViewer, const AActor* InViewTarget);
+
+public:
+	// 同步频率上限; 有属性变化时按此频率同步
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float MaxNetUpdateFrequency = 100.0f;
+
+	// 同步频率下限; 开启 net.UseAdaptiveNetUpdateFrequency 后无变化的Actor会逐渐衰减到此频率
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float MinNetUpdateFrequency = 10.0f;
+
+	// 在此距离内不做距离衰减
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float NearDistance = 1500.0f;
+
+	// 超出此距离后优先级缩放到 FarPriorityScale
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float FarDistance = 8000.0f;
+
+	// 远处观察者的优先级缩放
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float FarPriorityScale = 0.25f;
+
+	// 位于观察者视野背后时额外的优先级缩放
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float BehindViewPriorityScale = 0.5f;
+
+	// 网络裁剪距离; <= 0 表示沿用Actor自身的 NetCullDistanceSquared
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|Network")
+	float NetCullDistance = 0.0f;
+};
@@ -0,0 +1,147 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * 均匀空间网格: 格子 -> 格内对象(弱引用); 武器拾取管理器与可交互物注册表共用
+ * 对象按包围盒登记进其覆盖的所有格子, 查询时只遍历范围覆盖的格子; 跨格对象可能被重复访问, 由调用方去重
+ * 格子边长只在网格为空时采纳新值, 避免新旧格子混用
+ */
+template <typename ElementType>
+class TGRBUniformGrid
+{
+public:
+	// 一个对象覆盖的格子范围(闭区间)
+	struct FCellRange
+	{
+		FIntVector Min = FIntVector::ZeroValue;
+		FIntVector Max = FIntVector::ZeroValue;
+
+		bool operator==(const FCellRange& Other) const { return Min == Other.Min && Max == Other.Max; }
+		bool operator!=(const FCellRange& Other) const { return !(*this == Other); }
+
+		///--@brief 覆盖的格子数--/
+		int32 NumCells() const
+		{
+			const FIntVector Extent = Max - Min + FIntVector(1, 1, 1);
+			return Extent.X * Extent.Y * Extent.Z;
+		}
+	};
+
+	///--@brief 网格为空时采纳新的格子边长; 非空时忽略--/
+	void SetCellSizeIfEmpty(float InCellSize)
+	{
+		if (Cells.Num() == 0)
+		{
+			CellSize = InCellSize;
+		}
+	}
+
+	///--@brief 清空全部格子--/
+	void Reset()
+	{
+		Cells.Empty();
+	}
+
+	///--@brief 是否没有任何格子--/
+	bool IsEmpty() const { return Cells.Num() == 0; }
+
+	///--@brief 世界坐标所在的格子--/
+	FIntVector GetCellCoord(const FVector& InLocation) const
+	{
+		return FIntVector(
+			FMath::FloorToInt(InLocation.X / CellSize),
+			FMath::FloorToInt(InLocation.Y / CellSize),
+			FMath::FloorToInt(InLocation.Z / CellSize)
+		);
+	}
+
+	///--@brief 包围盒覆盖的格子范围--/
+	FCellRange GetCellRange(const FBox& InBounds) const
+	{
+		FCellRange Range;
+		Range.Min = GetCellCoord(InBounds.Min);
+		Range.Max = GetCellCoord(InBounds.Max);
+		return Range;
+	}
+
+	///--@brief 球形范围覆盖的格子范围--/
+	FCellRange GetCellRange(const FVector& InLocation, float InRadius) const
+	{
+		return GetCellRange(FBox(InLocation - FVector(InRadius), InLocation + FVector(InRadius)));
+	}
+
+	///--@brief 登记进格子范围内的每个格子--/
+	void Add(const FCellRange& InRange, ElementType* InElement)
+	{
+		ForEachCellCoord(InRange, [this, InElement](const FIntVector& InCell)
+		{
+			Cells.FindOrAdd(InCell).Add(InElement);
+		});
+	}
+
+	///--@brief 从格子范围内移除; 同时清掉已失效的弱引用, 格子空了一并删除--/
+	void Remove(const FCellRange& InRange, ElementType* InElement)
+	{
+		ForEachCellCoord(InRange, [this, InElement](const FIntVector& InCell)
+		{
+			if (TArray<TWeakObjectPtr<ElementType>>* const CellElements = Cells.Find(InCell))
+			{
+				CellElements->RemoveAllSwap([InElement](const TWeakObjectPtr<ElementType>& WeakElement) { return !WeakElement.IsValid() || WeakElement.Get() == InElement; }, false);
+				if (CellElements->Num() == 0)
+				{
+					Cells.Remove(InCell);
+				}
+			}
+		});
+	}
+
+	///--@brief 遍历格子范围内的有效对象; 跨格对象可能被访问多次--/
+	template <typename FuncType>
+	void ForEachInRange(const FCellRange& InRange, FuncType&& InFunc) const
+	{
+		if (Cells.Num() == 0)
+		{
+			return;
+		}
+		ForEachCellCoord(InRange, [this, &InFunc](const FIntVector& InCell)
+		{
+			if (const TArray<TWeakObjectPtr<ElementType>>* const CellElements = Cells.Find(InCell))
+			{
+				for (const TWeakObjectPtr<ElementType>& WeakElement : *CellElements)
+				{
+					if (ElementType* const Element = WeakElement.Get())
+					{
+						InFunc(Element);
+					}
+				}
+			}
+		});
+	}
+
+private:
+	template <typename FuncType>
+	static void ForEachCellCoord(const FCellRange& InRange, FuncType&& InFunc)
+	{
+		for (int32 X = InRange.Min.X; X <= InRange.Max.X; ++X)
+		{
+			for (int32 Y = InRange.Min.Y; Y <= InRange.Max.Y; ++Y)
+			{
+				for (int32 Z = InRange.Min.Z; Z <= InRange.Max.Z; ++Z)
+				{
+					InFunc(FIntVector(X, Y, Z));
+				}
+			}
+		}
+	}
+
+private:
+	// 格子 -> 格内对象
+	TMap<FIntVector, TArray<TWeakObjectPtr<ElementType>>> Cells;
+
+	// 入格时使用的格子边长
+	float CellSize = 100.0f;
+};
@@ -0,0 +1,65 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GRBDamageNumberBatch.generated.h"
+
+class AGRBCharacterBase;
+
+/**
+ * 一个目标在一个聚合窗口内的伤害数字
+ */
+USTRUCT(BlueprintType)
+struct GRBSHOOTER_API FGRBDamageNumberEntry
+{
+	GENERATED_BODY()
+
+public:
+	// 受击目标
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|UI")
+	AGRBCharacterBase* TargetCharacter = nullptr;
+
+	// 窗口内累计伤害; 同步时量化为整数
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|UI")
+	float DamageAmount = 0.0f;
+
+	// 窗口内命中次数
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|UI")
+	int32 HitCount = 0;
+
+	// 窗口内是否有爆头
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|UI")
+	bool bHeadShot = false;
+};
+
+/**
+ * 一次下发给攻击者的伤害数字批次
+ * 服务端按目标合并一个窗口内的全部命中, 整批走一次不可靠RPC; 不再每次命中都发一个携带完整Tag容器的可靠RPC
+ * 网络序列化: 条目数 + 每条(目标引用, 量化伤害, 命中次数)的变长整数 + 按条目排列的爆头位掩码
+ */
+USTRUCT(BlueprintType)
+struct GRBSHOOTER_API FGRBDamageNumberBatch
+{
+	GENERATED_BODY()
+
+public:
+	// 单批最多条目数, 与爆头位掩码位宽一致
+	static constexpr int32 MaxEntries = 32;
+
+	///--@brief 量化并打包序列化--/
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|UI")
+	TArray<FGRBDamageNumberEntry> Entries;
+};
+
+template <>
+struct TStructOpsTypeTraits<FGRBDamageNumberBatch> : public TStructOpsTypeTraitsBase2<FGRBDamageNumberBatch>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
@@ -0,0 +1,29 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GRBPlayerCameraManager.generated.h"
+
+class UGRBFOVAnimatorComponent;
+
+/**
+ * 玩家相机管理器
+ * 在每帧相机更新前统一推进已登记的FOV动画器, 取代逐个Tick的FOV异步任务
+ */
+UCLASS()
+class GRBSHOOTER_API AGRBPlayerCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+public:
+	virtual void UpdateCamera(float DeltaTime) override;
+
+	///--@brief 登记一个有进行中插值的FOV动画器; 插值结束后自动移出--/
+	void RegisterFOVAnimator(UGRBFOVAnimatorComponent* InAnimator);
+
+private:
+	// 有进行中插值的FOV动画器
+	TArray<TWeakObjectPtr<UGRBFOVAnimatorComponent>> ActiveFOVAnimators;
+};
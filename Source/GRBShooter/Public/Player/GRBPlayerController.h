@@ -5,10 +5,15 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "Characters/GRBCharacterBase.h"
+#include "Player/GRBDamageNumberBatch.h"
 #include "GRBPlayerController.generated.h"
 
 class UPaperSprite;
 class UGRBHUDWidget;
+
+/** HUD被设置/重建; 缓存了旧HUD的使用方据此作废缓存 */
+DECLARE_MULTICAST_DELEGATE(FGRBOnHUDWidgetChanged);
+
 /**
  * 玩家控制器
  */
@@ -18,17 +23,44 @@ class GRBSHOOTER_API AGRBPlayerController : public APlayerController
 	GENERATED_BODY()
 
 public:
+	AGRBPlayerController();
+
 	UGRBHUDWidget* GetGRBHUD();
 
+	///--@brief 设置/重建HUD, 并广播 OnGRBHUDChanged--/
+	void SetGRBHUD(UGRBHUDWidget* InHUDWidget);
+
 	UFUNCTION(BlueprintCallable, Category = "GRBShooter|UI")
 	void SetHUDReticle(TSubclassOf<class UGRBHUDReticle> ReticleClass);
 
 	UFUNCTION(BlueprintCallable, Category = "GRBShooter|UI")
 	void SetEquippedWeaponStatusText(const FText& StatusText);
 	
-	UFUNCTION(Client, Reliable, WithValidation)
-	void ShowDamageNumber(float DamageAmount, AGRBCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags);
-	void ShowDamageNumber_Implementation(float DamageAmount, AGRBCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags);
-	bool ShowDamageNumber_Validate(float DamageAmount, AGRBCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags);
-	
+	///--@brief 服务端: 记下一次命中, 按目标并入当前聚合窗口; 窗口结束时整批下发--/
+	void QueueDamageNumber(float DamageAmount, AGRBCharacterBase* TargetCharacter, bool bHeadShot);
+
+	// 伤害数字只是表现, 丢包可接受, 走不可靠通道
+	UFUNCTION(Client, Unreliable)
+	void ClientShowDamageNumbers(const FGRBDamageNumberBatch& Batch);
+	void ClientShowDamageNumbers_Implementation(const FGRBDamageNumberBatch& Batch);
+
+public:
+	// HUD被设置/重建时广播
+	FGRBOnHUDWidgetChanged OnGRBHUDChanged;
+
+protected:
+	///--@brief 下发当前窗口内聚合的伤害数字--/
+	void FlushDamageNumbers();
+
+protected:
+	// 本地玩家的HUD
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|UI")
+	UGRBHUDWidget* UIHUDWidget;
+
+	// 服务端: 当前聚合窗口内按目标合并的伤害数字
+	UPROPERTY()
+	FGRBDamageNumberBatch PendingDamageNumbers;
+
+	// 服务端: 聚合窗口结束时的下发
+	FTimerHandle DamageNumberFlushTimerHandle;
 };
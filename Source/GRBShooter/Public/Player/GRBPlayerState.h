@@ -6,12 +6,15 @@
 #include "GameFramework/PlayerState.h"
 #include "AbilitySystemInterface.h"
 #include "GameplayEffectTypes.h"
+#include "GRBNetUpdatePolicy.h"
 #include "GRBPlayerState.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGRBOnGameplayAttributeValueChangedDelegate, FGameplayAttribute, Attribute, float, NewValue, float, OldValue);
 
+class AGRBPlayerController;
 class UGRBAttributeSetBase;
 class UGRBAmmoAttributeSet;
+class UGRBHUDWidget;
 
 
 /**
@@ -26,7 +29,9 @@ class GRBSHOOTER_API AGRBPlayerState : public APlayerState, public IAbilitySyste
 public:
 	AGRBPlayerState();
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
 	class UGRBAttributeSetBase* GetAttributeSetBase() const;
 	class UGRBAmmoAttributeSet* GetAmmoAttributeSet() const;
 
@@ -121,6 +126,18 @@ public:
 protected:
 	virtual void OnAttribute_HealthChangedCallback(const FOnAttributeChangeData& Data);
 	virtual void KnockDownTagChanged(const FGameplayTag CallbackTag, int32 NewCount);
+
+	///--@brief 取缓存的HUD; 缓存失效时向控制器重新取一次--/
+	UGRBHUDWidget* GetCachedHUD();
+
+	///--@brief HUD被重建, 作废缓存--/
+	void InvalidateCachedHUD();
+
+	///--@brief 本帧首次有提示变化时, 排一次下一帧的统一刷新; 非本地玩家直接丢弃--/
+	bool ScheduleUIFlush();
+
+	///--@brief 把累积的提示变化一次性写进HUD--/
+	void FlushPendingUI();
 	
 protected:
 	FGameplayTag DeadTag;
@@ -138,7 +155,42 @@ protected:
 	UPROPERTY()
 	UGRBAmmoAttributeSet* AmmoAttributeSet;
 
+	// 网络同步节流策略; ASC挂在玩家状态上, 上限保持高频, 空闲时自适应衰减, 远处观察者降低优先级
+	UPROPERTY(EditDefaultsOnly, Category = "GRBShooter|GRBPlayerState")
+	FGRBNetUpdatePolicy NetUpdatePolicy;
+
 	// Attribute changed delegate handles
 	FDelegateHandle HealthChangedDelegateHandle;
 	FDelegateHandle PawnKnockdownAddOrRemoveHandle;
+
+private:
+	// 单个提示在一帧内的最终操作; 同帧内多次切换只保留最后一次
+	enum class EGRBPendingUIOp : uint8
+	{
+		None,
+		Show,
+		Hide,
+	};
+
+	// 一帧内累积的提示变化
+	struct FGRBPendingUIState
+	{
+		EGRBPendingUIOp AbilityConfirmPrompt = EGRBPendingUIOp::None;
+		EGRBPendingUIOp InteractionPrompt = EGRBPendingUIOp::None;
+		float InteractionPromptDuration = 0.0f;
+		EGRBPendingUIOp InteractionTimer = EGRBPendingUIOp::None;
+		float InteractionTimerDuration = 0.0f;
+	};
+
+	FGRBPendingUIState PendingUI;
+
+	// 缓存的HUD; 弱引用, HUD被销毁后自动失效
+	TWeakObjectPtr<UGRBHUDWidget> CachedHUD;
+
+	// 已订阅了HUD重建通知的控制器
+	TWeakObjectPtr<AGRBPlayerController> HUDChangedSource;
+	FDelegateHandle HUDChangedDelegateHandle;
+
+	// 下一帧的统一刷新
+	FTimerHandle UIFlushTimerHandle;
 };
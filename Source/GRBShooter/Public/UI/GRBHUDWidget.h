@@ -6,6 +6,7 @@
 #include "Runtime/UMG/Public/Blueprint/UserWidget.h"
 #include "GRBHUDWidget.generated.h"
 
+class AGRBCharacterBase;
 class UPaperSprite;
 class UTexture2D;
 
@@ -20,4 +21,20 @@ class GRBSHOOTER_API UGRBHUDWidget : public UUserWidget
 public:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
 	void ShowAbilityConfirmPrompt(bool bShowText);
+
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	void ShowInteractionPrompt(float InteractionDuration);
+
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	void HideInteractionPrompt();
+
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	void StartInteractionTimer(float InteractionDuration);
+
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	void StopInteractionTimer();
+
+	// 聚合显示: 一个目标在一个聚合窗口内的累计伤害与命中次数合为一个数字
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
+	void ShowAggregatedDamageNumber(AGRBCharacterBase* TargetCharacter, float DamageAmount, int32 HitCount, bool bHeadShot);
 };
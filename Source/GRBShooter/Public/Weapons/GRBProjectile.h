@@ -3,10 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GRBNetUpdatePolicy.h"
 #include "Characters/Abilities/GRBAbilityTypes.h"
 #include "GameFramework/Actor.h"
 #include "GRBProjectile.generated.h"
 
+/**
+ * 带完整Actor语义的弹丸实体(挂载组件, 蓝图逻辑)
+ * 大批量的普通弹丸请走 UGRBProjectileManagerSubsystem 的轻量模拟
+ */
 UCLASS()
 class GRBSHOOTER_API AGRBProjectile : public AActor
 {
@@ -16,14 +21,25 @@ public:
 	AGRBProjectile();
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
 
 	UFUNCTION(BlueprintCallable)
 	void OnSphereCompOvlp(AActor* InOtherActor);
 
+	///--@brief 爆炸索敌: 一次球形重叠查询收集存活的GRB角色并去重; 可选地再做一轮批量视线遮挡检测--/
+	static void CollectExplosionTargets(const UWorld* InWorld, const FVector& InOrigin, float InRadius, bool bInRequireLineOfSight, TArray<class AGRBCharacterBase*>& OutTargets);
+
 public:
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Buss", meta=(ExposeOnSpawn="true"))
+	// 开火者的ASC; 由开火技能在生成时传入, 仅随初始包同步一次
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category="Buss", meta=(ExposeOnSpawn="true"))
 	class UGRBAbilitySystemComponent* mGRBASC = nullptr;
 
+	// 开火Cue参数; 由开火技能在生成时预先算好, 仅随初始包同步一次
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category="Buss", meta=(ExposeOnSpawn="true"))
+	FGameplayCueParameters mFireCueParameters;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Buss", meta=(ExposeOnSpawn="true"))
 	FGRBGameplayEffectContainerSpec mGRBGEContainerSpecPak = FGRBGameplayEffectContainerSpec();
 
@@ -33,12 +49,26 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Buss", meta=(ExposeOnSpawn="true"))
 	TArray<class AGRBCharacterBase*> mHitTargets;
 
+	// 爆炸是否要求与目标之间没有静态几何遮挡
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Buss", meta=(ExposeOnSpawn="true"))
+	bool mExplosionRequiresLineOfSight = false;
+
+	// 是否为追踪弹; 在生成时传入, BeginPlay时才真正交给移动组件
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category="Buss", meta=(ExposeOnSpawn="true"))
 	bool mIsHoming = false;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Buss", meta=(ExposeOnSpawn="true"))
+	// 追踪目标; 在生成时传入, 仅随初始包同步一次
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category="Buss", meta=(ExposeOnSpawn="true"))
 	AActor* mHomingTarget = nullptr;
 
+	// 追踪瞄点; 移动组件每帧只朝它转向, 它的位置由 UGRBProjectileManagerSubsystem 按较低频率批量外推刷新
+	UPROPERTY(Transient)
+	USceneComponent* mHomingAimPoint = nullptr;
+
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "PBProjectile")
 	class UProjectileMovementComponent* ProjectileMovement;
+
+	// 网络同步节流策略; 客户端自行模拟弹道, 服务端只需低频纠正
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "PBProjectile")
+	FGRBNetUpdatePolicy NetUpdatePolicy;
 };
@@ -0,0 +1,249 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Characters/Abilities/GRBAbilityTypes.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/Info.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GRBProjectileManagerSubsystem.generated.h"
+
+class UGRBAbilitySystemComponent;
+class AGRBProjectile;
+class AGRBProjectileReplicator;
+
+DECLARE_STATS_GROUP(TEXT("GRBProjectile"), STATGROUP_GRBProjectile, STATCAT_Advanced);
+
+/**
+ * 轻量弹丸的生成参数; 仅服务端使用, 本身不参与网络复制
+ * 由开火技能填好后交给 UGRBProjectileManagerSubsystem::SpawnProjectile
+ */
+USTRUCT(BlueprintType)
+struct FGRBProjectileSpawnParams
+{
+	GENERATED_BODY()
+
+public:
+	// 出生位置
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	FVector Origin = FVector::ZeroVector;
+
+	// 出生朝向(无需归一化)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	FVector Direction = FVector::ForwardVector;
+
+	// 初速; 与 AGRBProjectile::ProjectileMovement->InitialSpeed 保持一致
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	float Speed = 7000.0f;
+
+	// 重力缩放
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	float GravityScale = 0.0f;
+
+	// 弹体扫掠半径
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	float CollisionRadius = 10.0f;
+
+	// 爆炸半径
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	float ExplosionRadius = 200.0f;
+
+	// 最长存活时长, 超时后原地爆炸
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	float LifeSpan = 10.0f;
+
+	// 追踪目标; 为空则为直射弹
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	AActor* HomingTarget = nullptr;
+
+	// 追踪加速度幅值
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	float HomingAccelerationMagnitude = 0.0f;
+
+	// 开火者
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	AActor* Instigator = nullptr;
+
+	// 开火者的ASC, 用于播放命中Cue
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	UGRBAbilitySystemComponent* InstigatorASC = nullptr;
+
+	// 爆炸时要应用的BUFF容器; 仅服务端持有
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	FGRBGameplayEffectContainerSpec EffectContainerSpec;
+
+	// 命中/爆炸时双端播放的Cue
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRBProjectile")
+	FGameplayTag ImpactCueTag;
+};
+
+/**
+ * 轻量弹丸的出生事件; 服务端只复制这一份数据, 客户端拿到后自行确定性模拟
+ */
+USTRUCT()
+struct FGRBProjectileSpawnEvent
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	uint32 ProjectileId = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Origin;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Velocity;
+
+	UPROPERTY()
+	float GravityScale = 0.0f;
+
+	UPROPERTY()
+	float CollisionRadius = 0.0f;
+
+	UPROPERTY()
+	float LifeSpan = 0.0f;
+
+	UPROPERTY()
+	float HomingAccelerationMagnitude = 0.0f;
+
+	UPROPERTY()
+	AActor* HomingTarget = nullptr;
+
+	UPROPERTY()
+	AActor* Instigator = nullptr;
+
+	UPROPERTY()
+	FGameplayTag ImpactCueTag;
+
+	// 服务端出生时刻; 客户端据此快进以抵消网络延迟
+	UPROPERTY()
+	float ServerSpawnTime = 0.0f;
+};
+
+/**
+ * 非Actor的轻量弹丸模拟管理器
+ * 所有弹丸以结构体数组(SoA)的形式连续存放, 每帧统一做一次积分, 一次追踪转向, 再逐行扫掠检测(整批共用一份查询参数)
+ * 服务端仅复制出生事件(见 AGRBProjectileReplicator), 客户端按同一套规则确定性模拟表现; 伤害结算只在服务端进行
+ * 需要完整Actor语义(挂载组件, 蓝图逻辑)的少数弹丸仍然走 AGRBProjectile
+ */
+UCLASS()
+class GRBSHOOTER_API UGRBProjectileManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	///--@brief 服务端生成一枚轻量弹丸, 返回其ID; 客户端调用无效返回0--/
+	UFUNCTION(BlueprintCallable, Category = "GRBShooter|GRBProjectile")
+	int32 SpawnProjectile(const FGRBProjectileSpawnParams& InParams);
+
+	///--@brief 当前正在模拟的弹丸数量--/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|GRBProjectile")
+	int32 GetNumActiveProjectiles() const { return ProjectileIds.Num(); }
+
+	///--@brief 客户端收到服务端打包的出生事件后进入--/
+	void ReceiveSpawnEvents(const TArray<FGRBProjectileSpawnEvent>& InSpawnEvents);
+
+	///--@brief 复制器Actor开始运作时登记到本管理器--/
+	void RegisterReplicator(AGRBProjectileReplicator* InReplicator);
+
+	///--@brief 登记一枚Actor形态的追踪弹, 由本管理器统一按低频刷新其追踪瞄点--/
+	void RegisterHomingProjectile(AGRBProjectile* InProjectile);
+
+	///--@brief 注销Actor形态的追踪弹--/
+	void UnregisterHomingProjectile(AGRBProjectile* InProjectile);
+
+	///--@brief 按目标当前速度外推出追踪瞄点; 提前量取弹丸飞抵目标的预估时长, 并受最大提前量约束--/
+	static FVector ExtrapolateHomingAimPoint(const AActor* InTarget, const FVector& InProjectileLocation, float InProjectileSpeed);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	///--@brief 把一条出生事件落成SoA里的一行; InFastForward为需要补帧的时长--/
+	int32 AddSimulatedProjectile(const FGRBProjectileSpawnEvent& InSpawnEvent, float InFastForward);
+
+	///--@brief 按 GRB.projectile.HomingUpdateRate 的频率, 一次遍历刷新所有追踪弹(轻量与Actor两种形态)的追踪瞄点--/
+	void UpdateHomingAimPoints(float DeltaTime);
+
+	///--@brief 追踪转向; 每帧只朝缓存的瞄点转向, 不访问目标Actor--/
+	void UpdateHoming(float DeltaTime);
+
+	///--@brief 积分步; 对连续数组做一次线性遍历--/
+	void IntegrateProjectiles(float DeltaTime);
+
+	///--@brief 扫掠检测; 每行一次球形扫掠, 输出命中的行号及命中结果--/
+	void SweepProjectiles(TArray<int32>& OutImpactIndices, TArray<FHitResult>& OutImpactHits);
+
+	///--@brief 处理一次命中: 双端播放Cue, 服务端结算爆炸伤害--/
+	void ResolveImpact(int32 InIndex, const FHitResult& InImpactHit);
+
+	///--@brief 以交换删除的方式移除一行, 保持数组连续--/
+	void RemoveProjectileAtSwap(int32 InIndex);
+
+	///--@brief 把本帧累计的出生事件一次性交给复制器发出--/
+	void FlushPendingSpawnEvents();
+
+	float GetServerWorldTimeSeconds() const;
+
+private:
+	// ~ SoA; 所有数组下标一一对应 ~
+	TArray<uint32> ProjectileIds;
+	TArray<FVector> Positions;
+	TArray<FVector> PrevPositions;
+	TArray<FVector> Velocities;
+	TArray<float> GravityScales;
+	TArray<float> CollisionRadii;
+	TArray<float> RemainingLifeSpans;
+	TArray<float> HomingAccelerations;
+	TArray<TWeakObjectPtr<AActor>> HomingTargets;
+	TArray<FVector> HomingAimPoints;
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+	TArray<TWeakObjectPtr<UGRBAbilitySystemComponent>> InstigatorASCs;
+	TArray<FGameplayTag> ImpactCueTags;
+
+	// 以下两列仅服务端有意义; 客户端保持默认值以维持数组等长
+	TArray<float> ExplosionRadii;
+	TArray<FGRBGameplayEffectContainerSpec> EffectContainerSpecs;
+
+	// Actor形态的追踪弹
+	TArray<TWeakObjectPtr<AGRBProjectile>> HomingActorProjectiles;
+
+	// 距离上次刷新追踪瞄点累计的时长
+	float HomingUpdateAccumulator = 0.0f;
+
+	// 本帧待发出的出生事件
+	TArray<FGRBProjectileSpawnEvent> PendingSpawnEvents;
+
+	// 负责发出出生事件的复制器
+	TWeakObjectPtr<AGRBProjectileReplicator> Replicator;
+
+	// 自增的弹丸ID
+	uint32 NextProjectileId = 1;
+};
+
+/**
+ * 轻量弹丸出生事件的网络载体
+ * 由服务端的 UGRBProjectileManagerSubsystem 生成, 始终相关, 本身不做属性同步, 只负责多播打包好的出生事件
+ */
+UCLASS(NotBlueprintable)
+class GRBSHOOTER_API AGRBProjectileReplicator : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+	AGRBProjectileReplicator();
+	virtual void BeginPlay() override;
+
+	///--@brief 多播一帧内累计的出生事件; 必须可靠: 客户端没有别的途径补回漏掉的弹丸, 丢一包就会少一枚飞行表现与追踪--/
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastSpawnProjectiles(const TArray<FGRBProjectileSpawnEvent>& InSpawnEvents);
+	void MulticastSpawnProjectiles_Implementation(const TArray<FGRBProjectileSpawnEvent>& InSpawnEvents);
+};
@@ -7,7 +7,9 @@
 #include "AbilitySystemInterface.h"
 #include "GameplayAbilitySpec.h"
 #include "GameplayTagContainer.h"
+#include "GRBNetUpdatePolicy.h"
 #include "GRBShooter/GRBShooter.h"
+#include "Weapons/GRBWeaponClipAmmo.h"
 #include "GRBWeapon.generated.h"
 
 class AGRBGATA_LineTrace;
@@ -16,9 +18,27 @@ class AGRBHeroCharacter;
 class UAnimMontage;
 class UGRBAbilitySystemComponent;
 class UGRBGameplayAbility;
+class UGRBWeaponDefinition;
 class UPaperSprite;
 class USkeletalMeshComponent;
 
+/**
+ * 武器枪皮的展示状态
+ * 装备切换只在这几种预先算好的状态间翻转, 不重新挂接
+ */
+UENUM(BlueprintType)
+enum class EGRBWeaponMeshState : uint8
+{
+	// 场景拾取物: 仅3P枪皮可见
+	Pickup,
+	// 在背包内未装备: 双视角枪皮隐藏, 动画Tick停掉或降为仅渲染时Tick
+	Holstered,
+	// 第一视角装备: 1P可见, 3P隐藏但投射阴影
+	Equipped1P,
+	// 第三视角装备: 仅3P可见
+	Equipped3P,
+};
+
 /** 武器载弹量变化的通用委托.*/
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FWeaponAmmoChangedDelegate, int32, OldValue, int32, NewValue);
 
@@ -45,10 +65,12 @@ private:
 
 public:
 	AGRBWeapon();
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
 	virtual void NotifyActorBeginOverlap(class AActor* Other) override;
 	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
@@ -70,6 +92,15 @@ public:
 	// 接口: 给特定pawn配置与本枪支武器关联.
 	void SetOwningCharacter(AGRBHeroCharacter* InOwningCharacter);
 
+	///--@brief 英雄进入拾取范围; 由拾取管理器在服务端调用--/
+	void OnPickupProximity(AGRBHeroCharacter* InCharacter);
+
+	///--@brief 切换枪皮展示状态; 与当前状态相同时直接返回--/
+	void SetMeshState(EGRBWeaponMeshState InMeshState);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|GRBWeapon")
+	EGRBWeaponMeshState GetMeshState() const { return MeshState; }
+
 	// Called when the player equips this weapon
 	virtual void Equip();
 
@@ -111,6 +142,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GRBShooter|GRBWeapon")
 	virtual void SetMaxSecondaryClipAmmo(int32 NewMaxSecondaryClipAmmo);
 
+	///--@brief 扣除主弹匣载弹量; 本地预测端按预测Key记账并在Key被拒绝时回滚, 服务端直接扣除--/
+	void SpendPrimaryClipAmmo(int32 InAmount, const FPredictionKey& InPredictionKey);
+
 	UFUNCTION(BlueprintCallable, Category = "GRBShooter|GRBWeapon")
 	TSubclassOf<class UGRBHUDReticle> GetPrimaryHUDReticleClass() const;
 
@@ -137,24 +171,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GRBShooter|Targeting")
 	AGRBGATA_SphereTrace* GetSphereTraceTargetActor();
 
+	///--@brief 武器定义烘焙好的开火参数; 未配置武器定义时返回空, 技能沿用自身默认值--/
+	const struct FGRBWeaponFireParams* GetFireParams() const;
+
 protected:
 	// Called when the player picks up this weapon
 	virtual void PickUpOnTouch(AGRBHeroCharacter* InCharacter);
 
+	///--@brief 打包载弹量同步回来; 逐项与本地值比较并广播变化--/
 	UFUNCTION()
-	virtual void OnRep_PrimaryClipAmmo(int32 OldPrimaryClipAmmo);
+	virtual void OnRep_ClipAmmo(const FGRBWeaponClipAmmo& OldClipAmmo);
 
-	UFUNCTION()
-	virtual void OnRep_MaxPrimaryClipAmmo(int32 OldMaxPrimaryClipAmmo);
+	///--@brief 改写单项载弹量; 服务端标记推送脏, 本地预测端只改本地值--/
+	void UpdateClipAmmo(int32 FGRBWeaponClipAmmo::* InField, int32 InNewValue, FWeaponAmmoChangedDelegate& InChangedDelegate);
 
-	UFUNCTION()
-	virtual void OnRep_SecondaryClipAmmo(int32 OldSecondaryClipAmmo);
+	///--@brief 预测扣弹的Key被服务端确认或拒绝--/
+	void OnPredictedAmmoSpendResolved(FPredictionKey::KeyType InKey, bool bRejected);
 
-	UFUNCTION()
-	virtual void OnRep_MaxSecondaryClipAmmo(int32 OldMaxSecondaryClipAmmo);
+	///--@brief 丢弃已被服务端确认的预测扣弹; 之后以同步回来的载弹量为准--/
+	void DiscardCaughtUpAmmoSpends();
+
+	///--@brief 主弹匣预测值变化时广播--/
+	void NotifyPrimaryClipAmmoChanged(int32 InOldPrimaryClipAmmo);
+
+	///--@brief 按归属与枪皮状态切换网络休眠; 仅服务端--/
+	void RefreshNetDormancy();
+
+	///--@brief 服务端: 丢弃者前方拾取范围之外的落地点; 前方被挡则退到挡住处, 向下贴地--/
+	FVector ComputeDropLocation(const AGRBHeroCharacter* InDropper) const;
+
+	///--@brief 服务端: 登记/注销为可拾取; 登记期间随根组件移动重新入格--/
+	void SetRegisteredAsPickup(bool bInRegistered);
+
+	///--@brief 登记为可拾取期间根组件移动: 按新位置重新入格--/
+	void OnPickupTransformUpdated(USceneComponent* InUpdatedComponent, EUpdateTransformFlags InUpdateTransformFlags, ETeleportType InTeleport);
 
 public:
-	// 依据拾取模式设定是否启用碰撞, 枪支作为场景道具时候是拾取碰撞, 作为直接生成物的时候关闭碰撞
+	// 是否以拾取模式生成; 枪支作为场景道具时登记进拾取管理器, 作为直接生成物的时候不登记
 	// Whether or not to spawn this weapon with collision enabled (pickup mode).
 	// Set to false when spawning directly into a player's inventory or true when spawning into the world in pickup mode.
 	UPROPERTY(BlueprintReadWrite)
@@ -200,28 +253,71 @@ public:
 	UPROPERTY(BlueprintReadWrite, VisibleInstanceOnly, Category = "GRBShooter|GRBWeapon")
 	FText StatusText;
 
+	// 武器定义: 开火/弹道/扩散/蒙太奇/效果参数; 技能在缓存阶段整包读取并在装备后一次性配置探查器
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|GRBWeapon")
+	UGRBWeaponDefinition* WeaponDefinition;
+
+	// 网络同步节流策略; 无主(掉落在地)时直接休眠
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GRBShooter|GRBWeapon")
+	FGRBNetUpdatePolicy NetUpdatePolicy;
+
 protected:
 	UPROPERTY()
 	UGRBAbilitySystemComponent* AbilitySystemComponent;
 
-	// 主弹匣
+	// 主弹匣初始载弹量; 运行时载弹量见 ClipAmmo
 	// How much ammo in the clip the gun starts with
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, ReplicatedUsing = OnRep_PrimaryClipAmmo, Category = "GRBShooter|GRBWeapon|Ammo")
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GRBShooter|GRBWeapon|Ammo")
 	int32 PrimaryClipAmmo;
 
-	// 主弹匣最大载弹量
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, ReplicatedUsing = OnRep_MaxPrimaryClipAmmo, Category = "GRBShooter|GRBWeapon|Ammo")
+	// 主弹匣初始最大载弹量
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GRBShooter|GRBWeapon|Ammo")
 	int32 MaxPrimaryClipAmmo;
 
-	// 备用弹匣载弹量
+	// 备用弹匣初始载弹量
 	// How much ammo in the clip the gun starts with. Used for things like rifle grenades.
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, ReplicatedUsing = OnRep_SecondaryClipAmmo, Category = "GRBShooter|GRBWeapon|Ammo")
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GRBShooter|GRBWeapon|Ammo")
 	int32 SecondaryClipAmmo;
 
-	// 最大备用弹匣载弹量
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, ReplicatedUsing = OnRep_MaxSecondaryClipAmmo, Category = "GRBShooter|GRBWeapon|Ammo")
+	// 备用弹匣初始最大载弹量
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GRBShooter|GRBWeapon|Ammo")
 	int32 MaxSecondaryClipAmmo;
 
+	// 运行时载弹量(服务端权威值); 打包为一个属性, 仅同步给持有者且走推送模型; 本地预测的扣弹另行记账
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_ClipAmmo, Category = "GRBShooter|GRBWeapon|Ammo")
+	FGRBWeaponClipAmmo ClipAmmo;
+
+	// 本地预测端的一笔扣弹; 服务端同步的载弹量覆盖它之前一直从主弹匣里扣掉
+	struct FPredictedAmmoSpend
+	{
+		FPredictionKey::KeyType Key = 0;
+		int32 Amount = 0;
+		// 预测时所基于的权威载弹量
+		int32 BaseClipAmmo = 0;
+		// 服务端扣掉这一笔(及之前各笔)后权威载弹量应有的值; 同步值降到它即说明已体现
+		int32 ExpectedClipAmmo = 0;
+		bool bCaughtUp = false;
+	};
+
+	///--@brief 同步回来的权威载弹量是否已体现这笔预测扣弹--/
+	bool IsAmmoSpendReflected(const FPredictedAmmoSpend& InSpend) const;
+
+	// 尚未被服务端载弹量覆盖的预测扣弹
+	TArray<FPredictedAmmoSpend> PredictedAmmoSpends;
+
+	// 预测扣弹总量; GetPrimaryClipAmmo 返回同步值减去它
+	int32 PredictedPrimaryAmmoSpent = 0;
+
+	// 已确认的扣弹迟迟等不到载弹量同步时的兜底清理
+	FTimerHandle CaughtUpAmmoSpendTimerHandle;
+
+	// 登记为可拾取期间, 根组件移动时重新入格的回调
+	FDelegateHandle PickupTransformUpdatedHandle;
+
+	// 最近一次丢下本武器的英雄与时刻; 冷却内该英雄不会把它立刻拾回
+	TWeakObjectPtr<AGRBHeroCharacter> LastDroppedBy;
+	float LastDropTime = 0.0f;
+
 	// 是否开启作弊 无限弹匣
 	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GRBShooter|GRBWeapon|Ammo")
 	bool bInfiniteAmmo;
@@ -236,7 +332,7 @@ protected:
 	UPROPERTY()
 	AGRBGATA_SphereTrace* SphereTraceTargetActor;
 
-	// 当为拾取模式时候的武器碰撞体
+	// 武器根组件; 拾取改由拾取管理器的空间哈希判定, 胶囊体不再开启碰撞
 	// Collision capsule for when weapon is in pickup mode
 	UPROPERTY(VisibleAnywhere)
 	class UCapsuleComponent* CollisionComp;
@@ -263,6 +359,10 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GRBShooter|GRBWeapon")
 	AGRBHeroCharacter* OwningCharacter;
 
+	// 枪皮当前展示状态; 各端由背包组件本地推导, 不参与同步
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "GRBShooter|GRBWeapon")
+	EGRBWeaponMeshState MeshState;
+
 	// 武器/枪支 会在蓝图内携带一些技能
 	UPROPERTY(EditAnywhere, Category = "GRBShooter|GRBWeapon")
 	TArray<TSubclassOf<UGRBGameplayAbility>> Abilities;
@@ -0,0 +1,56 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GRBWeaponClipAmmo.generated.h"
+
+/**
+ * 武器弹匣载弹量的打包同步结构
+ * 四项载弹量合为一个属性, 只同步给持有者(COND_OwnerOnly)并走推送模型; 全自动开火时每发的扣弹不再向所有客户端产生属性同步
+ * 网络序列化时量化为 [0, 65535], 先写一个非零位掩码, 再逐项写变长整数; 备用弹匣为空的武器只占主弹匣两项的字节
+ */
+USTRUCT(BlueprintType)
+struct GRBSHOOTER_API FGRBWeaponClipAmmo
+{
+	GENERATED_BODY()
+
+public:
+	///--@brief 量化并打包序列化--/
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FGRBWeaponClipAmmo& Other) const
+	{
+		return PrimaryClipAmmo == Other.PrimaryClipAmmo && MaxPrimaryClipAmmo == Other.MaxPrimaryClipAmmo
+			&& SecondaryClipAmmo == Other.SecondaryClipAmmo && MaxSecondaryClipAmmo == Other.MaxSecondaryClipAmmo;
+	}
+
+	bool operator!=(const FGRBWeaponClipAmmo& Other) const { return !(*this == Other); }
+
+public:
+	// 主弹匣载弹量
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|GRBWeapon|Ammo")
+	int32 PrimaryClipAmmo = 0;
+
+	// 主弹匣最大载弹量
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|GRBWeapon|Ammo")
+	int32 MaxPrimaryClipAmmo = 0;
+
+	// 备用弹匣载弹量
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|GRBWeapon|Ammo")
+	int32 SecondaryClipAmmo = 0;
+
+	// 备用弹匣最大载弹量
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|GRBWeapon|Ammo")
+	int32 MaxSecondaryClipAmmo = 0;
+};
+
+template <>
+struct TStructOpsTypeTraits<FGRBWeaponClipAmmo> : public TStructOpsTypeTraitsBase2<FGRBWeaponClipAmmo>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,227 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "GRBWeaponDefinition.generated.h"
+
+class AGameplayAbilityWorldReticle;
+class AGRBGATA_LineTrace;
+class AGRBGATA_SphereTrace;
+class UAnimMontage;
+class UGameplayEffect;
+class UMeshComponent;
+
+/**
+ * 单个场景探查器的弹道/扩散参数
+ * 武器定义里编辑; 烘焙后原样带进运行时参数包, 每次装备时一次性写进探查器
+ */
+USTRUCT(BlueprintType)
+struct GRBSHOOTER_API FGRBWeaponTraceParams
+{
+	GENERATED_BODY()
+
+public:
+	///--@brief 一次性写入射线探查器的全部配置; 返回探查器的配置版本号--/
+	uint32 ConfigureLineTrace(AGRBGATA_LineTrace* InTraceActor, const FGameplayAbilityTargetingLocationInfo& InStartLocation) const;
+
+	///--@brief 一次性写入球型探查器的全部配置; 返回探查器的配置版本号--/
+	uint32 ConfigureSphereTrace(AGRBGATA_SphereTrace* InTraceActor, const FGameplayAbilityTargetingLocationInfo& InStartLocation) const;
+
+	///--@brief 构建以枪口插槽为起点的目标位置信息--/
+	FGameplayAbilityTargetingLocationInfo MakeMuzzleLocation(UMeshComponent* InWeaponMesh) const;
+
+public:
+	// trace业务用到的碰撞profile
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	FCollisionProfileName TraceProfile = FCollisionProfileName(FName("Projectile"));
+
+	// 命中目标上显示的3D准星; 为空则不生成
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	TSubclassOf<AGameplayAbilityWorldReticle> ReticleClass;
+
+	// 枪口插槽; Trace起点
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	FName MuzzleSocketName = FName("MuzzleFlashSocket");
+
+	// 最大射距
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	float MaxRange = 99999999.0f;
+
+	// 球型Trace半径; 仅球型探查器使用
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	float TraceSphereRadius = 32.0f;
+
+	// 单次Trace承认的最大命中个数; < 1 只返回Trace终点
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	int32 MaxHitResultsPerTrace = 1;
+
+	// 每回合Trace次数; 霰弹枪类多发武器大于1
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	int32 NumberOfTraces = 1;
+
+	// 第一视角下是否从视角摄像机开始Trace; 第三视角一律从枪口
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	bool bTraceFromPlayerViewPoint = true;
+
+	// Trace是否影响瞄准pitch
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	bool bTraceAffectsAimPitch = true;
+
+	// 是否穿透阻挡
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	bool bIgnoreBlockingHits = false;
+
+	// 确认/取消前是否持续保留命中结果
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	bool bUsePersistentHitResults = false;
+
+	// 是否启用瞄准扩散调幅; 需同时配置两个瞄准Tag
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	bool bUseAimingSpreadMod = false;
+
+	// 基础扩散(角度)
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	float BaseSpread = 0.0f;
+
+	// 瞄准时的扩散乘数
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	float AimingSpreadMod = 0.0f;
+
+	// 持续射击的扩散增幅
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	float TargetingSpreadIncrement = 0.0f;
+
+	// 持续射击的扩散阈值
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	float TargetingSpreadMax = 0.0f;
+
+	// 瞄准时会授予的标签
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	FGameplayTag AimingTag;
+
+	// 瞄准移除时会授予的标签
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Spread")
+	FGameplayTag AimingRemovalTag;
+};
+
+/**
+ * 运行时开火参数包; 由 UGRBWeaponDefinition 在加载时烘焙
+ * 技能在缓存阶段整包读取, 开火路径上不再查表/加载资产/逐发配置探查器
+ */
+USTRUCT(BlueprintType)
+struct GRBSHOOTER_API FGRBWeaponFireParams
+{
+	GENERATED_BODY()
+
+public:
+	// 主开火探查器参数
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	FGRBWeaponTraceParams PrimaryTrace;
+
+	// 副开火/索敌探查器参数
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	FGRBWeaponTraceParams SecondaryTrace;
+
+	// 开火伤害BUFF
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	TSubclassOf<UGameplayEffect> DamageEffectClass;
+
+	// 腰射开火蒙太奇
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	UAnimMontage* FireMontage = nullptr;
+
+	// 瞄准开火蒙太奇; 未配置时沿用腰射蒙太奇
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	UAnimMontage* AimFireMontage = nullptr;
+
+	// 开火特效CueTag
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	FGameplayTag FireCueTag;
+
+	// 单发伤害
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	float Damage = 0.0f;
+
+	// 射击间隔(秒)
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	float TimeBetweenShots = 0.1f;
+
+	// 单回合射击消耗的弹量
+	UPROPERTY(BlueprintReadOnly, Category = "GRBShooter|Weapon")
+	int32 AmmoCost = 1;
+};
+
+/**
+ * 武器定义数据资产
+ * 集中配置开火/弹道/扩散/蒙太奇/效果参数, 取代散落在各技能构造器里的硬编码默认值
+ * 加载(PostLoad)与编辑器改值后烘焙为 FGRBWeaponFireParams; 武器通过 AGRBWeapon::WeaponDefinition 引用
+ */
+UCLASS(BlueprintType)
+class GRBSHOOTER_API UGRBWeaponDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PostLoad() override;
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	///--@brief 烘焙好的运行时开火参数--/
+	const FGRBWeaponFireParams& GetFireParams() const { return FireParams; }
+
+protected:
+	///--@brief 把编辑期参数规整为运行时参数包--/
+	void BakeFireParams();
+
+	///--@brief 规整单个探查器参数--/
+	static FGRBWeaponTraceParams BakeTraceParams(const FGRBWeaponTraceParams& InTraceParams);
+
+protected:
+	// 每分钟射速; 烘焙为射击间隔
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Fire", meta = (ClampMin = "1"))
+	float RoundsPerMinute = 600.0f;
+
+	// 单发伤害
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Fire")
+	float Damage = 10.0f;
+
+	// 单回合射击消耗的弹量
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Fire", meta = (ClampMin = "0"))
+	int32 AmmoCost = 1;
+
+	// 主开火探查器参数
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	FGRBWeaponTraceParams PrimaryTrace;
+
+	// 副开火/索敌探查器参数
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Trace")
+	FGRBWeaponTraceParams SecondaryTrace;
+
+	// 腰射开火蒙太奇
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	UAnimMontage* FireMontage = nullptr;
+
+	// 瞄准开火蒙太奇
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
+	UAnimMontage* AimFireMontage = nullptr;
+
+	// 开火伤害BUFF; 伤害值经 Data.Damage SetByCaller 传入
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
+	TSubclassOf<UGameplayEffect> DamageEffectClass;
+
+	// 开火特效CueTag
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Effect")
+	FGameplayTag FireCueTag;
+
+private:
+	// 烘焙结果
+	UPROPERTY(Transient)
+	FGRBWeaponFireParams FireParams;
+};
@@ -0,0 +1,79 @@
+// Copyright 2024 GRB.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GRBUniformGrid.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GRBWeaponPickupSubsystem.generated.h"
+
+class AGRBHeroCharacter;
+class AGRBWeapon;
+
+DECLARE_STATS_GROUP(TEXT("GRBPickup"), STATGROUP_GRBPickup, STATCAT_Advanced);
+
+/**
+ * 场景武器拾取管理器; 仅服务端运作
+ * 可拾取的武器登记进均匀空间哈希(格子边长 GRB.pickup.CellSize), 不再各自开启拾取胶囊体参与物理宽相
+ * 每帧只为本帧移动过的英雄查询其周边格子; 有新武器入表时补一次全量检查, 站着不动的英雄也能拾取脚下刚掉落的武器
+ */
+UCLASS()
+class GRBSHOOTER_API UGRBWeaponPickupSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	///--@brief 登记一把可拾取的武器; 已登记时按当前位置重新入格--/
+	void RegisterPickup(AGRBWeapon* InWeapon);
+
+	///--@brief 注销可拾取的武器(被拾取/销毁)--/
+	void UnregisterPickup(AGRBWeapon* InWeapon);
+
+	///--@brief 登记参与拾取检查的英雄--/
+	void RegisterPawn(AGRBHeroCharacter* InHero);
+
+	///--@brief 注销参与拾取检查的英雄--/
+	void UnregisterPawn(AGRBHeroCharacter* InHero);
+
+	///--@brief 英雄位置与武器的拾取距离(GRB.pickup.Radius)--/
+	static float GetPickupRadius();
+
+	///--@brief 当前登记的可拾取武器数量--/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "GRBShooter|GRBPickup")
+	int32 GetNumPickups() const { return PickupCells.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FPickupGrid = TGRBUniformGrid<AGRBWeapon>;
+
+	///--@brief 查询英雄周边格子内的武器并尝试拾取--/
+	void CheckPickupsAround(AGRBHeroCharacter* InHero, const FVector& InLocation);
+
+private:
+	// 英雄的拾取检查记录
+	struct FTrackedPawn
+	{
+		TWeakObjectPtr<AGRBHeroCharacter> Hero;
+		FVector LastCheckedLocation = FVector::ZeroVector;
+		bool bEverChecked = false;
+	};
+
+	// 空间哈希: 武器按位置落进单个格子
+	FPickupGrid Grid;
+
+	// 武器 -> 所在格子; 用于注销与重新入格
+	TMap<TObjectKey<AGRBWeapon>, FPickupGrid::FCellRange> PickupCells;
+
+	// 参与拾取检查的英雄
+	TArray<FTrackedPawn> TrackedPawns;
+
+	// 有新武器入表, 下一帧对所有英雄做一次全量检查
+	bool bPickupsAddedSinceLastTick = false;
+};
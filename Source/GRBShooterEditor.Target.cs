@@ -10,6 +10,7 @@ public class GRBShooterEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.Latest;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+		bWithPushModel = true;
 		ExtraModuleNames.AddRange( new string[] { "GRBShooter" } );
 	}
 }